@@ -23,10 +23,13 @@ SOURCES += \
     cfop.cpp \
     corners.cpp \
     cube.cpp \
+    cube_batch.cpp \
     deep_search.cpp \
     edges.cpp \
     main.cpp \
     mainwindow.cpp \
+    pruning.cpp \
+    thread_pool.cpp \
     tinyxml2.cpp
 
 HEADERS += \
@@ -34,10 +37,13 @@ HEADERS += \
     cfop.h \
     corners.h \
     cube.h \
+    cube_batch.h \
     cube_definitions.h \
     deep_search.h \
     edges.h \
     mainwindow.h \
+    pruning.h \
+    thread_pool.h \
     tinyxml2.h
 
 FORMS += \
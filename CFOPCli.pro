@@ -0,0 +1,47 @@
+# Command line CFOP solver, without Qt (qmake CFOPCli.pro && make)
+
+TEMPLATE = app
+TARGET = cfop_cli
+
+CONFIG += console c++11
+CONFIG -= app_bundle qt
+
+# remove possible other optimization flags
+QMAKE_CXXFLAGS_RELEASE -= -O
+QMAKE_CXXFLAGS_RELEASE -= -O1
+QMAKE_CXXFLAGS_RELEASE -= -O2
+
+# add the desired -O3 if not present
+QMAKE_CXXFLAGS_RELEASE += -O3
+
+# search threads
+unix: QMAKE_CXXFLAGS += -pthread
+unix: LIBS += -pthread
+
+SOURCES += \
+    algorithm.cpp \
+    cfop.cpp \
+    cfop_cli.cpp \
+    corners.cpp \
+    cube.cpp \
+    cube_batch.cpp \
+    deep_search.cpp \
+    edges.cpp \
+    pruning.cpp \
+    thread_pool.cpp
+
+HEADERS += \
+    algorithm.h \
+    cfop.h \
+    corners.h \
+    cube.h \
+    cube_batch.h \
+    cube_definitions.h \
+    deep_search.h \
+    edges.h \
+    pruning.h \
+    thread_pool.h
+
+# Default rules for deployment.
+unix:!android: target.path = /opt/$${TARGET}/bin
+!isEmpty(target.path): INSTALLS += target
@@ -1111,6 +1111,13 @@ namespace grcube3
 	// Append given algorithm at the end of the algorithm (no shrinking)
 	void Algorithm::Append(Algorithm& A) { uint size = A.GetSize(); for (uint n = 0u; n < size; n++) Append(A[n]); }
 	
+	// Check if the given char is allowed in a text algorithm (other chars are ignored when the text is read)
+	bool Algorithm::IsAlgorithmChar(const char c)
+	{
+		for (uint j = 0u; j < m_chars_SIZE; j++) if (c == m_chars[j]) return true;
+		return false;
+	}
+
 	 // Reads steps from plain text and append them to the algorithm
 	bool Algorithm::Append(string& ss)
 	{
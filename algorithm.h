@@ -39,6 +39,7 @@ namespace grcube3
 		~Algorithm() { } // Destructor
 		
 		Steps& operator[](const uint pos) { return Movs[pos]; } // Return step at position
+		Steps At(const uint pos) const { return Movs[pos]; } // Return step at position (constant algorithm)
 		bool operator==(Algorithm&) const; // Equal operator
 		bool operator!=(Algorithm&) const; // Not equal operator
 		Algorithm operator+(Algorithm&); // Algorithm addition operator
@@ -76,6 +77,7 @@ namespace grcube3
 		bool InsertParentheses(const uint, const uint, const uint = 1u); // Surround the given range in parentheses with the given repetitions
 		
 		std::string ToString(const char = ' ') const; // Return current algorithm as plain text string
+		static bool IsAlgorithmChar(const char); // Check if the given char is allowed in a text algorithm
 		
 		Algorithm GetDeveloped(const bool = false) const; // Gets the same algorithm with single or without parentheses -default- (steps inside parentheses developed)
 		Algorithm GetSimplified() const; // Gets the same algorithm with single layer movements and turns and no parentheses (should be used before applying the algorithm to a cube)
@@ -139,6 +141,9 @@ namespace grcube3
 		static bool OppositeSteps(const Steps S1, const Steps S2) {	return (m_layer[static_cast<int>(S1)] == m_layer_opposite[static_cast<int>(S2)]) /* &&
 			                                                               (m_range[static_cast<int>(S1)] == Ranges::SINGLE)*/; }
 		static std::string GetTextStep(const Steps s) { return m_strings[static_cast<uint>(s)]; }
+		static Steps GetInvertedStep(const Steps s) { return m_inverted[static_cast<uint>(s)]; } // Get the inverted movement of the given step
+		// Returns true if appending step S after steps Prev2 and Prev1 (in this order) shrinks the algorithm (use Steps::NONE for missing previous steps)
+		static bool ShrinkableSteps(const Steps Prev2, const Steps Prev1, const Steps S) { Steps SJ; return JoinSteps(Prev1, S, SJ) || JoinSteps(Prev2, Prev1, S, SJ); }
 
 	private:
 		std::vector<Steps> Movs; // Algorithm movements (steps)
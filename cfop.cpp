@@ -23,9 +23,141 @@
 #include "cfop.h"
 
 #include <chrono>
+#include <algorithm>
+#include <mutex>
 
 namespace grcube3
 {
+	// Static array with F2L solve algorithms (by case), for the front right pair (DFR corner and FR edge) with the cross in the
+	// down layer. Each case is given by the position of the corner D color sticker and the edge F color sticker
+	// The algorithms keep the cross and the other slots, the AUF before the algorithm is given by the recognition table
+	const std::vector<Algorithm> CFOP::F2L_Algorithms[41] =
+	{
+		{ // Corner UBL (D color in U), edge UB (F color in U)
+			Algorithm("R2 U2 R' U' R U' R2")
+		},
+		{ // Corner UBL (D color in U), edge UL (F color in L)
+			Algorithm("R B U B2 R B R2")
+		},
+		{ // Corner UBR (D color in B), edge UB (F color in U)
+			Algorithm("R U' R' U R U R'")
+		},
+		{ // Corner UBR (D color in B), edge UR (F color in R)
+			Algorithm("F' U F")
+		},
+		{ // Corner UBR (D color in U), edge UF (F color in F)
+			Algorithm("F' U2 F2 R' F' R")
+		},
+		{ // Corner UFL (D color in L), edge UF (F color in U)
+			Algorithm("R U' R'")
+		},
+		{ // Corner UFL (D color in L), edge UL (F color in L)
+			Algorithm("F' U F U' F' U' F")
+		},
+		{ // Corner UFL (D color in U), edge UR (F color in U)
+			Algorithm("R U B' R B R2")
+		},
+		{ // Corner UFR (D color in F), edge UB (F color in B)
+			Algorithm("R2 U B U' B' R2")
+		},
+		{ // Corner UFR (D color in F), edge UB (F color in U)
+			Algorithm("F2 L' U' L U F2")
+		},
+		{ // Corner UFR (D color in F), edge UF (F color in U)
+			Algorithm("F' U F U2 R U R'")
+		},
+		{ // Corner UFR (D color in F), edge UL (F color in L)
+			Algorithm("F' U' F")
+		},
+		{ // Corner UFR (D color in F), edge UL (F color in U)
+			Algorithm("R U B U2 B' U R'")
+		},
+		{ // Corner UFR (D color in F), edge UR (F color in R)
+			Algorithm("F U2 F2 U' F2 U' F'")
+		},
+		{ // Corner UFR (D color in R), edge UB (F color in B)
+			Algorithm("R2 U2 F R2 F' U2 R2")
+		},
+		{ // Corner UFR (D color in R), edge UB (F color in U)
+			Algorithm("R U R'")
+		},
+		{ // Corner UFR (D color in R), edge UF (F color in U)
+			Algorithm("R U' B U2 B' U2 R'")
+		},
+		{ // Corner UFR (D color in R), edge UL (F color in L)
+			Algorithm("R2 B U B' U' R2")
+		},
+		{ // Corner UFR (D color in R), edge UL (F color in U)
+			Algorithm("F2 U' L' U L F2")
+		},
+		{ // Corner UFR (D color in R), edge UR (F color in R)
+			Algorithm("R U' B U' B' U2 R'")
+		},
+		{ // Corner UFR (D color in U), edge UB (F color in B)
+			Algorithm("F' L' U2 L F")
+		},
+		{ // Corner UFR (D color in U), edge UF (F color in F)
+			Algorithm("F' U2 F U F' U' F")
+		},
+		{ // Corner UFR (D color in U), edge UL (F color in U)
+			Algorithm("R B U2 B' R'")
+		},
+		{ // Corner UFR (D color in U), edge UR (F color in U)
+			Algorithm("R U2 R' U' R U R'")
+		},
+		{ // Corner UBR (D color in R), edge FR (F color in F)
+			Algorithm("F' U2 L' U2 L F")
+		},
+		{ // Corner UBR (D color in R), edge FR (F color in R)
+			Algorithm("R B' R B R' U R'")
+		},
+		{ // Corner UFL (D color in F), edge FR (F color in F)
+			Algorithm("R U2 B U2 B' R'")
+		},
+		{ // Corner UFL (D color in F), edge FR (F color in R)
+			Algorithm("F' U' F U' R U R'")
+		},
+		{ // Corner UFR (D color in U), edge FR (F color in F)
+			Algorithm("R2 U R2 U R2 U2 R2")
+		},
+		{ // Corner UFR (D color in U), edge FR (F color in R)
+			Algorithm("F' U F R U2 R'")
+		},
+		{ // Corner DFR (D color in D), edge UF (F color in F)
+			Algorithm("R' U2 B' R B U2 R")
+		},
+		{ // Corner DFR (D color in D), edge UF (F color in U)
+			Algorithm("F' U2 F U2 R U R'")
+		},
+		{ // Corner DFR (D color in F), edge UL (F color in L)
+			Algorithm("R' F R F2 U' F")
+		},
+		{ // Corner DFR (D color in F), edge UR (F color in U)
+			Algorithm("F' U2 F R U2 R'")
+		},
+		{ // Corner DFR (D color in R), edge UF (F color in F)
+			Algorithm("F' U F2 R' F' R")
+		},
+		{ // Corner DFR (D color in R), edge UL (F color in U)
+			Algorithm("F' U F R U R'")
+		},
+		{ // Corner DFR (D color in D), edge FR (F color in R)
+			Algorithm("R2 U2 F R2 F' U2 R' U R'")
+		},
+		{ // Corner DFR (D color in F), edge FR (F color in F)
+			Algorithm("R2 U2 R' U' R U' R' U2 R'")
+		},
+		{ // Corner DFR (D color in F), edge FR (F color in R)
+			Algorithm("F' L' U2 L F R U R'")
+		},
+		{ // Corner DFR (D color in R), edge FR (F color in F)
+			Algorithm("F2 U' L' U L F2 R U R'")
+		},
+		{ // Corner DFR (D color in R), edge FR (F color in R)
+			Algorithm("R2 B U B' U' R' U R'")
+		}
+	};
+
 	// Static array with OLL solve algorithms (by case)
 	const std::vector<Algorithm> CFOP::OLL_Algorithms[58] =
 	{
@@ -541,6 +673,10 @@ namespace grcube3
 		"Ga", "Gb", "Gc", "Gd" // G permutations (double cycles)
 	};
 
+    // Turns and AUF steps for 1LLL, in search order
+    const Steps CFOP::Turns_1LLL[4] = { Steps::NONE, Steps::y, Steps::y2, Steps::yp };
+    const Steps CFOP::AUFs_1LLL[4] = { Steps::NONE, Steps::U, Steps::U2, Steps::Up };
+
     // Static vector with 1LLL solve algorithms
     std::vector<Algorithm> CFOP::Algorithms_1LLL =
     {
@@ -4544,10 +4680,30 @@ namespace grcube3
 
         CubeCross = CubeF2L = CubeOLL = CubeFinal = Cube1LLL = CubeBase;
         CrossTime = F2LTime = OLLTime = PLLTime = Time1LLL = 0.0f;
+        CrossNodes = F2LNodes = 0ull;
+        CrossStats = F2LStats = SearchStats();
 
 		LastCrossDeep = 0u;
 	}
 
+	// Time limit for the full solve (seconds from now, 0 for no limit)
+	void CFOP::SetTimeLimit(const double Seconds)
+	{
+		Deadline = Seconds > 0.0 ? std::chrono::steady_clock::now() + std::chrono::duration_cast<std::chrono::steady_clock::duration>(std::chrono::duration<double>(Seconds)) :
+								   std::chrono::steady_clock::time_point::max();
+	}
+
+	// Apply the search limits to a search, using the given part of the remaining time
+	void CFOP::SetSearchLimits(DeepSearch& DS, const double TimeShare) const
+	{
+		DS.SetCancel(Cancel);
+		if (Deadline == std::chrono::steady_clock::time_point::max()) return;
+
+		const auto Now = std::chrono::steady_clock::now();
+		if (Deadline <= Now) DS.SetDeadline(Now);
+		else DS.SetDeadline(Now + std::chrono::duration_cast<std::chrono::steady_clock::duration>((Deadline - Now) * TimeShare));
+	}
+
     // Search the best cross solve algorithm with the given search deep for the scramble
     // Returns false if no cross found
 	bool CFOP::SearchCross(const uint MaxDeep, const std::vector<PiecesGroups>& Crosses)
@@ -4586,15 +4742,32 @@ namespace grcube3
 		// (it's supose that the cross not will be solved in a single movement)
 		// All crosses will be evaluated separatelly, so multiple search is enabled here
 		DeepSearch DS_Cross(Scramble, CrossesGroup, SearchConf_Cross, true, true);
+		DS_Cross.SetCrossPruning(); // Skip the branches that can't reach a cross in the remaining movements
+		SetSearchLimits(DS_Cross, CROSS_TIME_SHARE); // The best cross found in time is used
+
+		// The solves are scored for each cross layer while searching
+		std::vector<Layers> CrossLayers;
+		if (UCtrl) CrossLayers.push_back(Layers::U);
+		if (DCtrl) CrossLayers.push_back(Layers::D);
+		if (FCtrl) CrossLayers.push_back(Layers::F);
+		if (BCtrl) CrossLayers.push_back(Layers::B);
+		if (RCtrl) CrossLayers.push_back(Layers::R);
+		if (LCtrl) CrossLayers.push_back(Layers::L);
+		F2LScorer CrossScorer(CrossLayers, SearchPolicies::BEST_SOLVES, DS_Cross.GetThreadsNumber(Cores));
+		CrossScorer.Attach(DS_Cross);
+
 		DS_Cross.Run(Cores);
+		if (DS_Cross.IsInterrupted()) Interrupted = true;
 		Cores = DS_Cross.GetCoresUsed(); // Update to the real number of cores used
+		CrossNodes = DS_Cross.GetNodes();
+		CrossStats = DS_Cross.GetStats();
 		
-		if (UCtrl) UCross_Score = DS_Cross.EvaluateF2LResult(UCross_Solve, Layers::U, SearchPolicies::BEST_SOLVES);
-		if (DCtrl) DCross_Score = DS_Cross.EvaluateF2LResult(DCross_Solve, Layers::D, SearchPolicies::BEST_SOLVES);
-		if (FCtrl) FCross_Score = DS_Cross.EvaluateF2LResult(FCross_Solve, Layers::F, SearchPolicies::BEST_SOLVES);
-		if (BCtrl) BCross_Score = DS_Cross.EvaluateF2LResult(BCross_Solve, Layers::B, SearchPolicies::BEST_SOLVES);
-		if (RCtrl) RCross_Score = DS_Cross.EvaluateF2LResult(RCross_Solve, Layers::R, SearchPolicies::BEST_SOLVES);
-		if (LCtrl) LCross_Score = DS_Cross.EvaluateF2LResult(LCross_Solve, Layers::L, SearchPolicies::BEST_SOLVES);
+		if (UCtrl) UCross_Score = CrossScorer.GetBest(Layers::U, UCross_Solve);
+		if (DCtrl) DCross_Score = CrossScorer.GetBest(Layers::D, DCross_Solve);
+		if (FCtrl) FCross_Score = CrossScorer.GetBest(Layers::F, FCross_Solve);
+		if (BCtrl) BCross_Score = CrossScorer.GetBest(Layers::B, BCross_Solve);
+		if (RCtrl) RCross_Score = CrossScorer.GetBest(Layers::R, RCross_Solve);
+		if (LCtrl) LCross_Score = CrossScorer.GetBest(Layers::L, LCross_Solve);
 
         // Get the layer with a best cross score
 		CrossLayer = GetBestScoreLayer(UCross_Score, DCross_Score, FCross_Score, BCross_Score, RCross_Score, LCross_Score);
@@ -4628,6 +4801,8 @@ namespace grcube3
         default: // Cross not found
 			Reset();
 			LastCrossDeep = MaxDeep;
+			CrossNodes = DS_Cross.GetNodes();
+			CrossStats = DS_Cross.GetStats();
 
             auto time_cross_end = std::chrono::system_clock::now();
             std::chrono::duration<double> cross_elapsed_seconds = time_cross_end - time_cross_start;
@@ -4645,6 +4820,157 @@ namespace grcube3
 		return true;
 	}
 
+	// Search the shortest XCross (or XXCross) with the given maximum deep for the crosses pieces groups
+	// Iterative deepening search, pruned with the XCross pruning table for each cross layer and F2L slot (exact distance for
+	// a XCross, so the search goes straight to the solve; for a XXCross the distance for the two nearest slots is used)
+	bool CFOP::SearchXCross(const uint MaxDeep, const std::vector<PiecesGroups>& Crosses, const bool XXCross)
+	{
+		auto time_cross_start = std::chrono::system_clock::now();
+
+		const PiecesGroups CrossesPieces[6] = { PiecesGroups::C_U, PiecesGroups::C_D, PiecesGroups::C_F,
+												PiecesGroups::C_B, PiecesGroups::C_R, PiecesGroups::C_L };
+		const Steps Inspections[6] = { Steps::z2, Steps::NONE, Steps::xp, Steps::x, Steps::z, Steps::zp };
+
+		// Cross layers to search (in the U, D, F, B, R, L order, without repetitions)
+		std::vector<uint> CrossLayers;
+		for (uint l = 0u; l < 6u; l++)
+			for (const auto& C : Crosses) if (C == CrossesPieces[l]) { CrossLayers.push_back(l); break; }
+
+		LastCrossDeep = MaxDeep;
+
+		XCrossData XC;
+		XC.Table = XCrossPruningTable::Get();
+		XC.Slots = static_cast<uint>(CrossLayers.size()) * 4u;
+		XC.Pairs = XXCross ? 2u : 1u;
+		XC.Cubes.resize((MaxDeep + 1u) * XC.Slots);
+		XC.Path.resize(MaxDeep);
+		XC.Nodes = 0ull;
+		XC.Deadline = Deadline;
+		if (Deadline != std::chrono::steady_clock::time_point::max())
+		{
+			const auto Now = std::chrono::steady_clock::now();
+			if (Deadline > Now) XC.Deadline = Now + std::chrono::duration_cast<std::chrono::steady_clock::duration>((Deadline - Now) * CROSS_TIME_SHARE);
+		}
+
+		const std::vector<F2LSymmetry>& F2LSymmetries = GetF2LSymmetries();
+		for (uint n = 0u; n < XC.Slots; n++)
+		{
+			const F2LSymmetry& FS = F2LSymmetries[CrossLayers[n / 4u] * 4u + n % 4u];
+			XC.Cubes[n] = CubeBase.GetSymmetric(FS.Sym);
+			for (uint s = static_cast<uint>(Steps::U); s <= static_cast<uint>(Steps::L2); s++)
+				XC.SlotSteps.push_back(Cube::GetSymmetricStep(FS.Sym, static_cast<Steps>(s)));
+		}
+
+		uint Layer = static_cast<uint>(CrossLayers.size()), Deep = 0u, BestLayer;
+		if (XC.Slots > 0u)
+			for (Deep = GetXCrossDistance(XC, 0u, BestLayer); Deep <= MaxDeep && !Interrupted; Deep++)
+			{
+				Layer = SearchXCrossLevel(XC, 0u, Deep);
+				if (Layer < CrossLayers.size()) break;
+			}
+
+		CrossNodes = XC.Nodes;
+
+		// The XCross search runs in a single thread, but the cores used (for the report) are the threads for the next searches,
+		// as in the cross search
+		if (Cores >= 0)
+		{
+			const int SystemCores = static_cast<int>(DeepSearch::GetSystemCores());
+			if (Cores == 0 || Cores >= SystemCores) Cores = SystemCores;
+		}
+
+		if (Layer >= CrossLayers.size()) // XCross not found
+		{
+			Reset();
+			LastCrossDeep = MaxDeep;
+			CrossNodes = XC.Nodes;
+
+			auto time_cross_end = std::chrono::system_clock::now();
+			std::chrono::duration<double> cross_elapsed_seconds = time_cross_end - time_cross_start;
+			CrossTime = cross_elapsed_seconds.count();
+
+			return false;
+		}
+
+		CrossLayer = static_cast<Layers>(static_cast<uint>(Layers::U) + CrossLayers[Layer]);
+		Turn_Inspection = Inspections[CrossLayers[Layer]];
+		Solve_Cross.Clear();
+		for (uint n = 0u; n < Deep; n++) Solve_Cross.Append(XC.Path[n]);
+
+		CubeCross = CubeBase;
+		CubeCross.ApplyAlgorithm(Solve_Cross);
+
+		auto time_cross_end = std::chrono::system_clock::now();
+		std::chrono::duration<double> cross_elapsed_seconds = time_cross_end - time_cross_start;
+		CrossTime = cross_elapsed_seconds.count();
+
+		return true;
+	}
+
+	// Movements needed for the XCross (or XXCross) in the best cross layer of the given level (and the layer index)
+	uint CFOP::GetXCrossDistance(const XCrossData& XC, const uint Level, uint& Layer)
+	{
+		uint Best = 0xFFu;
+		for (uint l = 0u; l < XC.Slots / 4u; l++)
+		{
+			uint Distances[4];
+			for (uint n = 0u; n < 4u; n++) Distances[n] = XC.Table->GetDistance(XC.Cubes[Level * XC.Slots + l * 4u + n]);
+			std::sort(Distances, Distances + 4);
+			if (Distances[XC.Pairs - 1u] < Best) { Best = Distances[XC.Pairs - 1u]; Layer = l; }
+		}
+		return Best;
+	}
+
+	// Check if the cross and the needed F2L pairs are solved in the given cross layer index of the given level
+	// (the rotated cubes have the cross in the down layer and the F2L slot in the front right position)
+	bool CFOP::IsXCrossSolved(const XCrossData& XC, const uint Level, const uint Layer)
+	{
+		uint Pairs = 0u;
+		for (uint n = 0u; n < 4u; n++)
+		{
+			const Cube& C = XC.Cubes[Level * XC.Slots + Layer * 4u + n];
+			if (!C.IsSolved(PiecesGroups::C_D)) return false;
+			if (C.IsSolved(PiecesGroups::F2L_D_DFR)) Pairs++;
+		}
+		return Pairs >= XC.Pairs;
+	}
+
+	// XCross depth-first search from the given level to the given deep, returns the solved cross layer index (layers number if not solved)
+	uint CFOP::SearchXCrossLevel(XCrossData& XC, const uint Level, const uint Deep)
+	{
+		const uint NoLayer = XC.Slots / 4u;
+
+		if ((++XC.Nodes & 0x3FFull) == 0ull && ((Cancel != nullptr && Cancel->IsCancelled()) || std::chrono::steady_clock::now() >= XC.Deadline))
+			Interrupted = true;
+		if (Interrupted) return NoLayer;
+
+		uint Layer = NoLayer;
+		const uint Distance = GetXCrossDistance(XC, Level, Layer);
+		if (Distance == 0u && IsXCrossSolved(XC, Level, Layer)) return Layer; // The table distance is confirmed with the cube
+		if (Level + Distance > Deep) return NoLayer;
+
+		const uint PrevLayer = Level > 0u ? (static_cast<uint>(XC.Path[Level - 1u]) - static_cast<uint>(Steps::U)) / 3u : 6u;
+		for (uint m = 0u; m < 18u; m++)
+		{
+			const uint StepLayer = m / 3u;
+			// Skip movements in the same layer than the previous movement, and in the opposite layer in only one order
+			if (StepLayer == PrevLayer || ((StepLayer ^ 1u) == PrevLayer && StepLayer < PrevLayer)) continue;
+
+			XC.Path[Level] = static_cast<Steps>(m + static_cast<uint>(Steps::U));
+			for (uint n = 0u; n < XC.Slots; n++)
+			{
+				Cube& C = XC.Cubes[(Level + 1u) * XC.Slots + n];
+				C = XC.Cubes[Level * XC.Slots + n];
+				C.ApplyStep(XC.SlotSteps[n * 18u + m]);
+			}
+
+			Layer = SearchXCrossLevel(XC, Level + 1u, Deep);
+			if (Layer < NoLayer) return Layer;
+			if (Interrupted) break;
+		}
+		return NoLayer;
+	}
+
     // Search the best F2L 'Solves' algorithms for the 'Scramble'
     // Returns true if the search is complete. If returns false, call this function again (executed step by step)
     bool CFOP::SearchF2LStep()
@@ -4693,11 +5019,12 @@ namespace grcube3
 		default: return true; // Invalid cross layer
 		}
 
-        // Apply all the current algorithms
-		Algorithm AuxAlg = Scramble + Solve_Cross +
-						   Solve_F2L_First + Solve_F2L_Second + Solve_F2L_Third + Solve_F2L_Fourth;
-
-		Cube CubeAux(AuxAlg);
+        // Continue from the cross cube state with the F2L algorithms already found
+		Cube CubeAux = CubeCross;
+		CubeAux.ApplyAlgorithm(Solve_F2L_First);
+		CubeAux.ApplyAlgorithm(Solve_F2L_Second);
+		CubeAux.ApplyAlgorithm(Solve_F2L_Third);
+		CubeAux.ApplyAlgorithm(Solve_F2L_Fourth);
 		bool F2L_1_IsSolved = CubeAux.IsSolved(F2L_1_Pieces),
 			 F2L_2_IsSolved = CubeAux.IsSolved(F2L_2_Pieces),
 			 F2L_3_IsSolved = CubeAux.IsSolved(F2L_3_Pieces),
@@ -4808,39 +5135,57 @@ namespace grcube3
 		// Get the score for algorithms found
 		uint F2L_1_Score = 0u, F2L_2_Score = 0u, F2L_3_Score = 0u, F2L_4_Score = 0u;
 
+		std::vector<PiecesGroups>* SlotPieces[4] = { &F2L_1_PiecesToSearch, &F2L_2_PiecesToSearch, &F2L_3_PiecesToSearch, &F2L_4_PiecesToSearch };
+		Algorithm* SlotSolves[4] = { &Solve_F2L_1, &Solve_F2L_2, &Solve_F2L_3, &Solve_F2L_4 };
+		uint* SlotScores[4] = { &F2L_1_Score, &F2L_2_Score, &F2L_3_Score, &F2L_4_Score };
+
+		std::vector<uint> Slots; // Slots to search
+		if (!F2L_1_IsSolved) Slots.push_back(0u);
+		if (!F2L_2_IsSolved) Slots.push_back(1u);
+		if (!F2L_3_IsSolved) Slots.push_back(2u);
+		if (!F2L_4_IsSolved) Slots.push_back(3u);
+
+		// The slots are searched together, continuing from the current cube state: a multiple search with a solve group for each
+		// slot (all pieces groups for the slot, cross + F2L, are evaluated together). The search tree is walked once for all the
+		// slots and the solves for each slot are the same as in a search for the slot alone
 		// As each level should be evaluated, first level is not extended in the F2L search
-		// All pieces groups (Cross + F2L) must be avaluated together, so multiple search is disabled
-		if (!F2L_1_IsSolved) // First F2L search
-		{
-			DeepSearch DS_1_F2L(AuxAlg, F2L_1_PiecesToSearch, SearchConf_F2L);
-			DS_1_F2L.Run(Cores);
-			Cores = DS_1_F2L.GetCoresUsed(); // Update to the real number of cores used
-			F2L_1_Score = DS_1_F2L.EvaluateF2LResult(Solve_F2L_1, CrossLayer, SearchPolicies::SHORT);
-		}
-		if (!F2L_2_IsSolved) // Second F2L search
-		{
-			DeepSearch DS_2_F2L(AuxAlg, F2L_2_PiecesToSearch, SearchConf_F2L);
-			DS_2_F2L.Run(Cores);
-			Cores = DS_2_F2L.GetCoresUsed(); // Update to the real number of cores used
-			F2L_2_Score = DS_2_F2L.EvaluateF2LResult(Solve_F2L_2, CrossLayer, SearchPolicies::SHORT);
-		}
-		if (!F2L_3_IsSolved) // Third F2L search
+		std::vector<std::vector<PiecesGroups>> SlotsGroups;
+		for (const auto Slot : Slots) SlotsGroups.push_back(*SlotPieces[Slot]);
+
+		DeepSearch DS_F2L(CubeAux, SlotsGroups, SearchConf_F2L);
+		SetSearchLimits(DS_F2L);
+		F2LScorer Scorer(CrossLayer, static_cast<uint>(Slots.size()), SearchPolicies::SHORT, DS_F2L.GetThreadsNumber(Cores)); // Longer solves are skipped
+		Scorer.Attach(DS_F2L);
+
+		// If the slot solve found in the last step still solves the slot, its score bounds the slot search from the start
+		// The search will find it (or a shorter solve in the same branch, with a better score), so the best solve is the same
+		for (uint g = 0u; g < Slots.size(); g++)
 		{
-			DeepSearch DS_3_F2L(AuxAlg, F2L_3_PiecesToSearch, SearchConf_F2L);
-			DS_3_F2L.Run(Cores);
-			Cores = DS_3_F2L.GetCoresUsed(); // Update to the real number of cores used
-			F2L_3_Score = DS_3_F2L.EvaluateF2LResult(Solve_F2L_3, CrossLayer, SearchPolicies::SHORT);
+			Algorithm& Seed = Solve_F2L_Seeds[Slots[g]];
+			if (Seed.GetSize() == 0u) continue;
+			Cube CubeSeed = CubeAux;
+			CubeSeed.ApplyAlgorithm(Seed);
+			bool SeedSolves = true;
+			for (const auto PG : SlotsGroups[g]) if (!CubeSeed.IsSolved(PG)) SeedSolves = false;
+			if (SeedSolves) Scorer.SetGroupMinScore(g, Scorer.GetGroupScore(g, CubeSeed, Seed.GetSize()));
 		}
-		if (!F2L_4_IsSolved) // Fourth F2L search
+
+		DS_F2L.Run(Cores);
+		if (DS_F2L.IsInterrupted()) Interrupted = F2LInterrupted = true;
+		F2LNodes += DS_F2L.GetNodes();
+		F2LStats.Add(DS_F2L.GetStats());
+
+		for (uint g = 0u; g < Slots.size(); g++)
 		{
-			DeepSearch DS_4_F2L(AuxAlg, F2L_4_PiecesToSearch, SearchConf_F2L);
-			DS_4_F2L.Run(Cores);
-			Cores = DS_4_F2L.GetCoresUsed(); // Update to the real number of cores used
-			F2L_4_Score = DS_4_F2L.EvaluateF2LResult(Solve_F2L_4, CrossLayer, SearchPolicies::SHORT);
+			const uint Slot = Slots[g];
+			*SlotScores[Slot] = Scorer.GetGroupBest(g, *SlotSolves[Slot]);
+			if (*SlotScores[Slot] > 0u) Solve_F2L_Seeds[Slot] = *SlotSolves[Slot];
+			else Solve_F2L_Seeds[Slot].Clear();
 		}
 
 		if (F2L_1_Score == 0u && F2L_2_Score == 0u && F2L_3_Score == 0u && F2L_4_Score == 0u)
 		{
+			if (F2LInterrupted) return true; // Search cut short, keep the F2L pairs already solved
 			Solve_F2L_First.Clear();
 			Solve_F2L_Second.Clear();
 			Solve_F2L_Third.Clear();
@@ -4912,168 +5257,408 @@ namespace grcube3
 		return false; // F2L search not complete
 	}
 
+	// Search the F2L with the F2L cases table
+	// In each step the case of each unsolved pair is recognized in the front right slot reference (rotating the cube), and the
+	// shortest algorithm is applied. The pairs with pieces in other unsolved slots can't be recognized
+	bool CFOP::SearchF2LCases(const bool SearchFallback)
+	{
+		auto time_F2L_start = std::chrono::system_clock::now();
+		F2LNodes = 0ull;
+		F2LStats = SearchStats();
+		F2LInterrupted = false;
+
+		Algorithm* SlotSolves[4] = { &Solve_F2L_1, &Solve_F2L_2, &Solve_F2L_3, &Solve_F2L_4 };
+		Algorithm* OrderSolves[4] = { &Solve_F2L_First, &Solve_F2L_Second, &Solve_F2L_Third, &Solve_F2L_Fourth };
+		for (uint n = 0u; n < 4u; n++)
+		{
+			SlotSolves[n]->Clear();
+			OrderSolves[n]->Clear();
+			Solve_F2L_Seeds[n].Clear();
+		}
+
+		PiecesGroups CrossPieces, F2L_Pieces[4];
+		if (!IsCrossSolved() || !DeepSearch::GetF2LPiecesGroups(CrossLayer, CrossPieces, F2L_Pieces)) return false; // No cross
+
+		const std::vector<F2LEntry>& F2LTable = GetF2LTable();
+		const F2LSymmetry* Symmetries = &GetF2LSymmetries()[(static_cast<uint>(CrossLayer) - static_cast<uint>(Layers::U)) * 4u];
+
+		// Recognition table entry for the slot (nullptr if the case is not recognized)
+		auto GetEntry = [&](const Cube& C, const uint Slot) -> const F2LEntry*
+		{
+			const F2LEntry& Entry = F2LTable[GetF2LIndex(C.GetSymmetric(Symmetries[Slot].Sym))];
+			return Entry.Valid ? &Entry : nullptr;
+		};
+
+		// Slot with the shortest recognized case (4 if none)
+		auto GetBestSlot = [&](const Cube& C) -> uint
+		{
+			uint BestSlot = 4u, BestLength = 0u;
+			for (uint n = 0u; n < 4u; n++)
+			{
+				if (C.IsSolved(F2L_Pieces[n])) continue;
+				const F2LEntry* Entry = GetEntry(C, n);
+				if (Entry != nullptr && (BestSlot == 4u || Entry->Length < BestLength)) { BestSlot = n; BestLength = Entry->Length; }
+			}
+			return BestSlot;
+		};
+
+		const Algorithm SlotOut("R U R'"); // Takes the front right slot pieces out to the up layer
+		Cube CubeAux = CubeCross; // Cube with the cross and the F2L algorithms already found
+		Algorithm Extraction; // Steps done to take pieces out of the slots, for the next F2L algorithm
+		uint Pairs = 0u; // F2L algorithms found
+
+		// Each step solves a pair or takes pieces out of a slot, the steps limit is not reached in a normal solve
+		for (uint Step = 0u; Step < 16u && Pairs < 4u && !F2LInterrupted; Step++)
+		{
+			bool Unsolved = false;
+			for (uint n = 0u; n < 4u; n++) if (!CubeAux.IsSolved(F2L_Pieces[n])) Unsolved = true;
+			if (!Unsolved) break; // F2L complete
+
+			const uint Slot = GetBestSlot(CubeAux);
+			if (Slot < 4u) // Solve the pair with the AUF and the stored algorithm, rotated to the slot
+			{
+				const F2LEntry* Entry = GetEntry(CubeAux, Slot);
+				const uint Inverse = Symmetries[Slot].Inverse;
+				Algorithm CaseSolve;
+				if (Entry->AUF != Steps::NONE) CaseSolve.Append(Cube::GetSymmetricStep(Inverse, Entry->AUF));
+				const Algorithm& CaseAlgorithm = F2L_Algorithms[Entry->Case][0];
+				for (uint i = 0u; i < CaseAlgorithm.GetSize(); i++) CaseSolve.Append(Cube::GetSymmetricStep(Inverse, CaseAlgorithm.At(i)));
+				CubeAux.ApplyAlgorithm(CaseSolve);
+
+				Algorithm Solve = Extraction + CaseSolve;
+				while (Solve.Shrink());
+				*SlotSolves[Slot] = *OrderSolves[Pairs++] = Solve;
+				Extraction.Clear();
+				continue;
+			}
+
+			// No pair can be recognized, use a F2L search step for the best pair
+			if (SearchFallback && Extraction.GetSize() == 0u)
+			{
+				Algorithm Saved[8];
+				for (uint n = 0u; n < 4u; n++) { Saved[n] = *SlotSolves[n]; Saved[n + 4u] = *OrderSolves[n]; }
+				SearchF2LStep();
+				if (OrderSolves[Pairs]->GetSize() > 0u) // New pair solved
+				{
+					CubeAux.ApplyAlgorithm(*OrderSolves[Pairs++]);
+					continue;
+				}
+				for (uint n = 0u; n < 4u; n++) { *SlotSolves[n] = Saved[n]; *OrderSolves[n] = Saved[n + 4u]; } // No pair found
+			}
+
+			// Take the pieces out of the first unsolved slot that allows to recognize a pair (or out of the first unsolved slot)
+			uint OutSlot = 4u;
+			for (uint n = 0u; n < 4u; n++)
+			{
+				if (CubeAux.IsSolved(F2L_Pieces[n])) continue;
+				if (OutSlot == 4u) OutSlot = n;
+				Cube CubeOut = CubeAux;
+				for (uint i = 0u; i < SlotOut.GetSize(); i++) CubeOut.ApplyStep(Cube::GetSymmetricStep(Symmetries[n].Inverse, SlotOut.At(i)));
+				if (GetBestSlot(CubeOut) < 4u) { OutSlot = n; break; }
+			}
+			for (uint i = 0u; i < SlotOut.GetSize(); i++)
+			{
+				const Steps S = Cube::GetSymmetricStep(Symmetries[OutSlot].Inverse, SlotOut.At(i));
+				CubeAux.ApplyStep(S);
+				Extraction.Append(S);
+			}
+		}
+
+		CubeF2L = CubeCross;
+		for (uint n = 0u; n < 4u; n++) CubeF2L.ApplyAlgorithm(*OrderSolves[n]);
+		CubeF2L.ApplyStep(Turn_Inspection); // Turn inspection must be applied here
+
+		auto time_F2L_end = std::chrono::system_clock::now();
+		std::chrono::duration<double> F2L_elapsed_seconds = time_F2L_end - time_F2L_start;
+		F2LTime = F2L_elapsed_seconds.count();
+
+		return IsF2LSolved();
+	}
+
+	// Get the F2L recognition table (case and AUF before the F2L algorithm for each pair position), built in the first use
+	const std::vector<CFOP::F2LEntry>& CFOP::GetF2LTable()
+	{
+		static const std::vector<F2LEntry> F2LTable = BuildF2LTable();
+		return F2LTable;
+	}
+
+	// Build the F2L recognition table
+	std::vector<CFOP::F2LEntry> CFOP::BuildF2LTable()
+	{
+		std::vector<F2LEntry> F2LTable(24u * 24u, F2LEntry{ 41u, Steps::NONE, 0u, false });
+
+		// Pair positions for all cases (cross in D layer, inverted AUF and F2L algorithm applied to a solved cube)
+		const Steps AUFSteps[4] = { Steps::NONE, Steps::U, Steps::U2, Steps::Up };
+		for (uint F2L_Index = 0u; F2L_Index < 41u; F2L_Index++)
+		{
+			Algorithm Inverse = F2L_Algorithms[F2L_Index][0].GetDeveloped(false);
+			Inverse.TransformReverseInvert();
+
+			for (const auto AUF : AUFSteps)
+			{
+				Cube CubeCase(Inverse);
+				CubeCase.ApplyStep(Algorithm::GetInvertedStep(AUF));
+				const uint Length = F2L_Algorithms[F2L_Index][0].GetNumSteps() + (AUF == Steps::NONE ? 0u : 1u);
+				F2LEntry& Entry = F2LTable[GetF2LIndex(CubeCase)];
+				if (!Entry.Valid || Length < Entry.Length) Entry = F2LEntry{ F2L_Index, AUF, Length, true }; // Shortest solve
+			}
+		}
+
+		return F2LTable;
+	}
+
+	// Get the F2L slots rotations, built in the first use
+	const std::vector<CFOP::F2LSymmetry>& CFOP::GetF2LSymmetries()
+	{
+		static const std::vector<F2LSymmetry> F2LSymmetries = BuildF2LSymmetries();
+		return F2LSymmetries;
+	}
+
+	// Build the F2L slots rotations
+	// The rotation must keep the pieces solved after each single step: the cross with the down cross and the slot with the front right slot
+	std::vector<CFOP::F2LSymmetry> CFOP::BuildF2LSymmetries()
+	{
+		std::vector<F2LSymmetry> F2LSymmetries(24u, F2LSymmetry{ 0u, 0u });
+
+		for (uint l = 0u; l < 6u; l++)
+		{
+			PiecesGroups CrossPieces, F2L_Pieces[4];
+			DeepSearch::GetF2LPiecesGroups(static_cast<Layers>(static_cast<uint>(Layers::U) + l), CrossPieces, F2L_Pieces);
+
+			for (uint n = 0u; n < 4u; n++)
+			{
+				F2LSymmetry& FS = F2LSymmetries[l * 4u + n];
+				for (uint Sym = 0u; Sym < Cube::SYMMETRIES; Sym++)
+				{
+					if (Cube::IsMirrorSymmetry(Sym)) continue;
+					bool Match = true;
+					for (uint s = static_cast<uint>(Steps::U); s <= static_cast<uint>(Steps::L2) && Match; s++)
+					{
+						Cube CubeStep;
+						CubeStep.ApplyStep(static_cast<Steps>(s));
+						const Cube CubeSym = CubeStep.GetSymmetric(Sym);
+						Match = CubeStep.IsSolved(CrossPieces) == CubeSym.IsSolved(PiecesGroups::C_D) &&
+								CubeStep.IsSolved(F2L_Pieces[n]) == CubeSym.IsSolved(PiecesGroups::F2L_D_DFR);
+					}
+					if (Match) { FS.Sym = Sym; break; }
+				}
+				for (uint Sym = 0u; Sym < Cube::SYMMETRIES; Sym++) // Inverse rotation
+				{
+					if (Cube::IsMirrorSymmetry(Sym)) continue;
+					bool Match = true;
+					for (uint s = static_cast<uint>(Steps::U); s <= static_cast<uint>(Steps::L2) && Match; s++)
+						Match = Cube::GetSymmetricStep(Sym, Cube::GetSymmetricStep(FS.Sym, static_cast<Steps>(s))) == static_cast<Steps>(s);
+					if (Match) { FS.Inverse = Sym; break; }
+				}
+			}
+		}
+
+		return F2LSymmetries;
+	}
+
 	// Orientation of last layer search
 	bool CFOP::SearchOLL()
 	{
         auto time_OLL_start = std::chrono::system_clock::now();
 
-		M16 MaskOLL = 0u;
-
 		if (!IsF2LSolved()) return false; // No F2L
 
         // Get the mask for OLL
-		switch (CrossLayer)
+		M16 MaskOLL = GetOLLMask(CubeF2L, CrossLayer);
+
+		if (MaskOLL == 0u) return false; // Can`t get mask
+
+		// Determine OLL case and OLL turn from the recognition table
+		const OLLEntry& Entry = GetOLLTable()[MaskOLL];
+		if (!Entry.Valid) return false; // No OLL case found
+
+		OLLCase = static_cast<OLL>(Entry.Case);
+		Turn_OLL = Entry.Turn;
+
+        // Get the OLL algorithm
+        Solve_OLL = OLL_Algorithms[static_cast<uint>(OLLCase)][0]; // Only use the first algorithms in the array
+
+		CubeOLL = CubeF2L;
+		CubeOLL.ApplyStep(Turn_OLL);
+		CubeOLL.ApplyTransform(GetOLLTransforms(CubeOLL.GetSpin())[Entry.Case]); // Precompiled OLL algorithm
+
+		auto time_OLL_end = std::chrono::system_clock::now();
+		std::chrono::duration<double> OLL_elapsed_seconds = time_OLL_end - time_OLL_start;
+		OLLTime = OLL_elapsed_seconds.count();
+
+		return true; // OLL found
+	}
+
+	// Get the mask for OLL from the given cube with the given cross layer (masks are in the OLL reference position)
+	M16 CFOP::GetOLLMask(const Cube& C, const Layers CL)
+	{
+		M16 MaskOLL = 0u;
+
+		switch (CL)
 		{
 		case Layers::U: // z2 as first inspection turn
-			if (CubeF2L.GetFace_DF_D() == Faces::D) MaskOLL |= 0x0001u; // Reference: UF_U
-			if (CubeF2L.GetFace_DB_D() == Faces::D) MaskOLL |= 0x0002u; // Reference: UB_U
-			if (CubeF2L.GetFace_DL_D() == Faces::D) MaskOLL |= 0x0004u; // Reference: UR_U
-			if (CubeF2L.GetFace_DR_D() == Faces::D) MaskOLL |= 0x0008u; // Reference: UL_U
-			if (CubeF2L.GetFace_DFL_D() == Faces::D) MaskOLL |= 0x0010u; // Reference: UFR_U
-			if (CubeF2L.GetFace_DFR_D() == Faces::D) MaskOLL |= 0x0020u; // Reference: UFL_U
-			if (CubeF2L.GetFace_DBL_D() == Faces::D) MaskOLL |= 0x0040u; // Reference: UBR_U
-			if (CubeF2L.GetFace_DBR_D() == Faces::D) MaskOLL |= 0x0080u; // Reference: UBL_U
-			if (CubeF2L.GetFace_DFL_F() == Faces::D) MaskOLL |= 0x0100u; // Reference: UFR_F
-			if (CubeF2L.GetFace_DFL_L() == Faces::D) MaskOLL |= 0x0200u; // Reference: UFR_R
-			if (CubeF2L.GetFace_DFR_F() == Faces::D) MaskOLL |= 0x0400u; // Reference: UFL_F
-			if (CubeF2L.GetFace_DFR_R() == Faces::D) MaskOLL |= 0x0800u; // Reference: UFL_L
-			if (CubeF2L.GetFace_DBL_B() == Faces::D) MaskOLL |= 0x1000u; // Reference: UBR_B
-			if (CubeF2L.GetFace_DBL_L() == Faces::D) MaskOLL |= 0x2000u; // Reference: UBR_R
-			if (CubeF2L.GetFace_DBR_B() == Faces::D) MaskOLL |= 0x4000u; // Reference: UBL_B
-			if (CubeF2L.GetFace_DBR_R() == Faces::D) MaskOLL |= 0x8000u; // Reference: UBL_L
+			if (C.GetFace_DF_D() == Faces::D) MaskOLL |= 0x0001u; // Reference: UF_U
+			if (C.GetFace_DB_D() == Faces::D) MaskOLL |= 0x0002u; // Reference: UB_U
+			if (C.GetFace_DL_D() == Faces::D) MaskOLL |= 0x0004u; // Reference: UR_U
+			if (C.GetFace_DR_D() == Faces::D) MaskOLL |= 0x0008u; // Reference: UL_U
+			if (C.GetFace_DFL_D() == Faces::D) MaskOLL |= 0x0010u; // Reference: UFR_U
+			if (C.GetFace_DFR_D() == Faces::D) MaskOLL |= 0x0020u; // Reference: UFL_U
+			if (C.GetFace_DBL_D() == Faces::D) MaskOLL |= 0x0040u; // Reference: UBR_U
+			if (C.GetFace_DBR_D() == Faces::D) MaskOLL |= 0x0080u; // Reference: UBL_U
+			if (C.GetFace_DFL_F() == Faces::D) MaskOLL |= 0x0100u; // Reference: UFR_F
+			if (C.GetFace_DFL_L() == Faces::D) MaskOLL |= 0x0200u; // Reference: UFR_R
+			if (C.GetFace_DFR_F() == Faces::D) MaskOLL |= 0x0400u; // Reference: UFL_F
+			if (C.GetFace_DFR_R() == Faces::D) MaskOLL |= 0x0800u; // Reference: UFL_L
+			if (C.GetFace_DBL_B() == Faces::D) MaskOLL |= 0x1000u; // Reference: UBR_B
+			if (C.GetFace_DBL_L() == Faces::D) MaskOLL |= 0x2000u; // Reference: UBR_R
+			if (C.GetFace_DBR_B() == Faces::D) MaskOLL |= 0x4000u; // Reference: UBL_B
+			if (C.GetFace_DBR_R() == Faces::D) MaskOLL |= 0x8000u; // Reference: UBL_L
 			break;
 		case Layers::D: // No turn as first inspection turn
-			if (CubeF2L.GetFace_UF_U() == Faces::U) MaskOLL |= 0x0001u; // Reference: UF_U
-			if (CubeF2L.GetFace_UB_U() == Faces::U) MaskOLL |= 0x0002u; // Reference: UB_U
-			if (CubeF2L.GetFace_UR_U() == Faces::U) MaskOLL |= 0x0004u; // Reference: UR_U
-			if (CubeF2L.GetFace_UL_U() == Faces::U) MaskOLL |= 0x0008u; // Reference: UL_U
-			if (CubeF2L.GetFace_UFR_U() == Faces::U) MaskOLL |= 0x0010u; // Reference: UFR_U
-			if (CubeF2L.GetFace_UFL_U() == Faces::U) MaskOLL |= 0x0020u; // Reference: UFL_U
-			if (CubeF2L.GetFace_UBR_U() == Faces::U) MaskOLL |= 0x0040u; // Reference: UBR_U
-			if (CubeF2L.GetFace_UBL_U() == Faces::U) MaskOLL |= 0x0080u; // Reference: UBL_U
-			if (CubeF2L.GetFace_UFR_F() == Faces::U) MaskOLL |= 0x0100u; // Reference: UFR_F
-			if (CubeF2L.GetFace_UFR_R() == Faces::U) MaskOLL |= 0x0200u; // Reference: UFR_R
-			if (CubeF2L.GetFace_UFL_F() == Faces::U) MaskOLL |= 0x0400u; // Reference: UFL_F
-			if (CubeF2L.GetFace_UFL_L() == Faces::U) MaskOLL |= 0x0800u; // Reference: UFL_L
-			if (CubeF2L.GetFace_UBR_B() == Faces::U) MaskOLL |= 0x1000u; // Reference: UBR_B
-			if (CubeF2L.GetFace_UBR_R() == Faces::U) MaskOLL |= 0x2000u; // Reference: UBR_R
-			if (CubeF2L.GetFace_UBL_B() == Faces::U) MaskOLL |= 0x4000u; // Reference: UBL_B
-			if (CubeF2L.GetFace_UBL_L() == Faces::U) MaskOLL |= 0x8000u; // Reference: UBL_L
+			if (C.GetFace_UF_U() == Faces::U) MaskOLL |= 0x0001u; // Reference: UF_U
+			if (C.GetFace_UB_U() == Faces::U) MaskOLL |= 0x0002u; // Reference: UB_U
+			if (C.GetFace_UR_U() == Faces::U) MaskOLL |= 0x0004u; // Reference: UR_U
+			if (C.GetFace_UL_U() == Faces::U) MaskOLL |= 0x0008u; // Reference: UL_U
+			if (C.GetFace_UFR_U() == Faces::U) MaskOLL |= 0x0010u; // Reference: UFR_U
+			if (C.GetFace_UFL_U() == Faces::U) MaskOLL |= 0x0020u; // Reference: UFL_U
+			if (C.GetFace_UBR_U() == Faces::U) MaskOLL |= 0x0040u; // Reference: UBR_U
+			if (C.GetFace_UBL_U() == Faces::U) MaskOLL |= 0x0080u; // Reference: UBL_U
+			if (C.GetFace_UFR_F() == Faces::U) MaskOLL |= 0x0100u; // Reference: UFR_F
+			if (C.GetFace_UFR_R() == Faces::U) MaskOLL |= 0x0200u; // Reference: UFR_R
+			if (C.GetFace_UFL_F() == Faces::U) MaskOLL |= 0x0400u; // Reference: UFL_F
+			if (C.GetFace_UFL_L() == Faces::U) MaskOLL |= 0x0800u; // Reference: UFL_L
+			if (C.GetFace_UBR_B() == Faces::U) MaskOLL |= 0x1000u; // Reference: UBR_B
+			if (C.GetFace_UBR_R() == Faces::U) MaskOLL |= 0x2000u; // Reference: UBR_R
+			if (C.GetFace_UBL_B() == Faces::U) MaskOLL |= 0x4000u; // Reference: UBL_B
+			if (C.GetFace_UBL_L() == Faces::U) MaskOLL |= 0x8000u; // Reference: UBL_L
 			break;
 		case Layers::F: // x' as first inspection turn
-			if (CubeF2L.GetFace_UB_B() == Faces::B) MaskOLL |= 0x0001u; // Reference: UF_U
-			if (CubeF2L.GetFace_DB_B() == Faces::B) MaskOLL |= 0x0002u; // Reference: UB_U
-			if (CubeF2L.GetFace_BR_B() == Faces::B) MaskOLL |= 0x0004u; // Reference: UR_U
-			if (CubeF2L.GetFace_BL_B() == Faces::B) MaskOLL |= 0x0008u; // Reference: UL_U
-			if (CubeF2L.GetFace_UBR_B() == Faces::B) MaskOLL |= 0x0010u; // Reference: UFR_U
-			if (CubeF2L.GetFace_UBL_B() == Faces::B) MaskOLL |= 0x0020u; // Reference: UFL_U
-			if (CubeF2L.GetFace_DBR_B() == Faces::B) MaskOLL |= 0x0040u; // Reference: UBR_U
-			if (CubeF2L.GetFace_DBL_B() == Faces::B) MaskOLL |= 0x0080u; // Reference: UBL_U
-			if (CubeF2L.GetFace_UBR_U() == Faces::B) MaskOLL |= 0x0100u; // Reference: UFR_F
-			if (CubeF2L.GetFace_UBR_R() == Faces::B) MaskOLL |= 0x0200u; // Reference: UFR_R
-			if (CubeF2L.GetFace_UBL_U() == Faces::B) MaskOLL |= 0x0400u; // Reference: UFL_F
-			if (CubeF2L.GetFace_UBL_L() == Faces::B) MaskOLL |= 0x0800u; // Reference: UFL_L
-			if (CubeF2L.GetFace_DBR_D() == Faces::B) MaskOLL |= 0x1000u; // Reference: UBR_B
-			if (CubeF2L.GetFace_DBR_R() == Faces::B) MaskOLL |= 0x2000u; // Reference: UBR_R
-			if (CubeF2L.GetFace_DBL_D() == Faces::B) MaskOLL |= 0x4000u; // Reference: UBL_B
-			if (CubeF2L.GetFace_DBL_L() == Faces::B) MaskOLL |= 0x8000u; // Reference: UBL_L
+			if (C.GetFace_UB_B() == Faces::B) MaskOLL |= 0x0001u; // Reference: UF_U
+			if (C.GetFace_DB_B() == Faces::B) MaskOLL |= 0x0002u; // Reference: UB_U
+			if (C.GetFace_BR_B() == Faces::B) MaskOLL |= 0x0004u; // Reference: UR_U
+			if (C.GetFace_BL_B() == Faces::B) MaskOLL |= 0x0008u; // Reference: UL_U
+			if (C.GetFace_UBR_B() == Faces::B) MaskOLL |= 0x0010u; // Reference: UFR_U
+			if (C.GetFace_UBL_B() == Faces::B) MaskOLL |= 0x0020u; // Reference: UFL_U
+			if (C.GetFace_DBR_B() == Faces::B) MaskOLL |= 0x0040u; // Reference: UBR_U
+			if (C.GetFace_DBL_B() == Faces::B) MaskOLL |= 0x0080u; // Reference: UBL_U
+			if (C.GetFace_UBR_U() == Faces::B) MaskOLL |= 0x0100u; // Reference: UFR_F
+			if (C.GetFace_UBR_R() == Faces::B) MaskOLL |= 0x0200u; // Reference: UFR_R
+			if (C.GetFace_UBL_U() == Faces::B) MaskOLL |= 0x0400u; // Reference: UFL_F
+			if (C.GetFace_UBL_L() == Faces::B) MaskOLL |= 0x0800u; // Reference: UFL_L
+			if (C.GetFace_DBR_D() == Faces::B) MaskOLL |= 0x1000u; // Reference: UBR_B
+			if (C.GetFace_DBR_R() == Faces::B) MaskOLL |= 0x2000u; // Reference: UBR_R
+			if (C.GetFace_DBL_D() == Faces::B) MaskOLL |= 0x4000u; // Reference: UBL_B
+			if (C.GetFace_DBL_L() == Faces::B) MaskOLL |= 0x8000u; // Reference: UBL_L
 			break;
 		case Layers::B: // x as first inspection turn
-			if (CubeF2L.GetFace_DF_F() == Faces::F) MaskOLL |= 0x0001u; // Reference: UF_U
-			if (CubeF2L.GetFace_UF_F() == Faces::F) MaskOLL |= 0x0002u; // Reference: UB_U
-			if (CubeF2L.GetFace_FR_F() == Faces::F) MaskOLL |= 0x0004u; // Reference: UR_U
-			if (CubeF2L.GetFace_FL_F() == Faces::F) MaskOLL |= 0x0008u; // Reference: UL_U
-			if (CubeF2L.GetFace_DFR_F() == Faces::F) MaskOLL |= 0x0010u; // Reference: UFR_U
-			if (CubeF2L.GetFace_DFL_F() == Faces::F) MaskOLL |= 0x0020u; // Reference: UFL_U
-			if (CubeF2L.GetFace_UFR_F() == Faces::F) MaskOLL |= 0x0040u; // Reference: UBR_U
-			if (CubeF2L.GetFace_UFL_F() == Faces::F) MaskOLL |= 0x0080u; // Reference: UBL_U
-			if (CubeF2L.GetFace_DFR_D() == Faces::F) MaskOLL |= 0x0100u; // Reference: UFR_F
-			if (CubeF2L.GetFace_DFR_R() == Faces::F) MaskOLL |= 0x0200u; // Reference: UFR_R
-			if (CubeF2L.GetFace_DFL_D() == Faces::F) MaskOLL |= 0x0400u; // Reference: UFL_F
-			if (CubeF2L.GetFace_DFL_L() == Faces::F) MaskOLL |= 0x0800u; // Reference: UFL_L
-			if (CubeF2L.GetFace_UFR_U() == Faces::F) MaskOLL |= 0x1000u; // Reference: UBR_B
-			if (CubeF2L.GetFace_UFR_R() == Faces::F) MaskOLL |= 0x2000u; // Reference: UBR_R
-			if (CubeF2L.GetFace_UFL_U() == Faces::F) MaskOLL |= 0x4000u; // Reference: UBL_B
-			if (CubeF2L.GetFace_UFL_L() == Faces::F) MaskOLL |= 0x8000u; // Reference: UBL_L
+			if (C.GetFace_DF_F() == Faces::F) MaskOLL |= 0x0001u; // Reference: UF_U
+			if (C.GetFace_UF_F() == Faces::F) MaskOLL |= 0x0002u; // Reference: UB_U
+			if (C.GetFace_FR_F() == Faces::F) MaskOLL |= 0x0004u; // Reference: UR_U
+			if (C.GetFace_FL_F() == Faces::F) MaskOLL |= 0x0008u; // Reference: UL_U
+			if (C.GetFace_DFR_F() == Faces::F) MaskOLL |= 0x0010u; // Reference: UFR_U
+			if (C.GetFace_DFL_F() == Faces::F) MaskOLL |= 0x0020u; // Reference: UFL_U
+			if (C.GetFace_UFR_F() == Faces::F) MaskOLL |= 0x0040u; // Reference: UBR_U
+			if (C.GetFace_UFL_F() == Faces::F) MaskOLL |= 0x0080u; // Reference: UBL_U
+			if (C.GetFace_DFR_D() == Faces::F) MaskOLL |= 0x0100u; // Reference: UFR_F
+			if (C.GetFace_DFR_R() == Faces::F) MaskOLL |= 0x0200u; // Reference: UFR_R
+			if (C.GetFace_DFL_D() == Faces::F) MaskOLL |= 0x0400u; // Reference: UFL_F
+			if (C.GetFace_DFL_L() == Faces::F) MaskOLL |= 0x0800u; // Reference: UFL_L
+			if (C.GetFace_UFR_U() == Faces::F) MaskOLL |= 0x1000u; // Reference: UBR_B
+			if (C.GetFace_UFR_R() == Faces::F) MaskOLL |= 0x2000u; // Reference: UBR_R
+			if (C.GetFace_UFL_U() == Faces::F) MaskOLL |= 0x4000u; // Reference: UBL_B
+			if (C.GetFace_UFL_L() == Faces::F) MaskOLL |= 0x8000u; // Reference: UBL_L
 			break;
 		case Layers::R: // z as first inspection turn
-			if (CubeF2L.GetFace_FL_L() == Faces::L) MaskOLL |= 0x0001u; // Reference: UF_U
-			if (CubeF2L.GetFace_BL_L() == Faces::L) MaskOLL |= 0x0002u; // Reference: UB_U
-			if (CubeF2L.GetFace_UL_L() == Faces::L) MaskOLL |= 0x0004u; // Reference: UR_U
-			if (CubeF2L.GetFace_DL_L() == Faces::L) MaskOLL |= 0x0008u; // Reference: UL_U
-			if (CubeF2L.GetFace_UFL_L() == Faces::L) MaskOLL |= 0x0010u; // Reference: UFR_U
-			if (CubeF2L.GetFace_DFL_L() == Faces::L) MaskOLL |= 0x0020u; // Reference: UFL_U
-			if (CubeF2L.GetFace_UBL_L() == Faces::L) MaskOLL |= 0x0040u; // Reference: UBR_U
-			if (CubeF2L.GetFace_DBL_L() == Faces::L) MaskOLL |= 0x0080u; // Reference: UBL_U
-			if (CubeF2L.GetFace_UFL_F() == Faces::L) MaskOLL |= 0x0100u; // Reference: UFR_F
-			if (CubeF2L.GetFace_UFL_U() == Faces::L) MaskOLL |= 0x0200u; // Reference: UFR_R
-			if (CubeF2L.GetFace_DFL_F() == Faces::L) MaskOLL |= 0x0400u; // Reference: UFL_F
-			if (CubeF2L.GetFace_DFL_D() == Faces::L) MaskOLL |= 0x0800u; // Reference: UFL_L
-			if (CubeF2L.GetFace_UBL_B() == Faces::L) MaskOLL |= 0x1000u; // Reference: UBR_B
-			if (CubeF2L.GetFace_UBL_U() == Faces::L) MaskOLL |= 0x2000u; // Reference: UBR_R
-			if (CubeF2L.GetFace_DBL_B() == Faces::L) MaskOLL |= 0x4000u; // Reference: UBL_B
-			if (CubeF2L.GetFace_DBL_D() == Faces::L) MaskOLL |= 0x8000u; // Reference: UBL_L
+			if (C.GetFace_FL_L() == Faces::L) MaskOLL |= 0x0001u; // Reference: UF_U
+			if (C.GetFace_BL_L() == Faces::L) MaskOLL |= 0x0002u; // Reference: UB_U
+			if (C.GetFace_UL_L() == Faces::L) MaskOLL |= 0x0004u; // Reference: UR_U
+			if (C.GetFace_DL_L() == Faces::L) MaskOLL |= 0x0008u; // Reference: UL_U
+			if (C.GetFace_UFL_L() == Faces::L) MaskOLL |= 0x0010u; // Reference: UFR_U
+			if (C.GetFace_DFL_L() == Faces::L) MaskOLL |= 0x0020u; // Reference: UFL_U
+			if (C.GetFace_UBL_L() == Faces::L) MaskOLL |= 0x0040u; // Reference: UBR_U
+			if (C.GetFace_DBL_L() == Faces::L) MaskOLL |= 0x0080u; // Reference: UBL_U
+			if (C.GetFace_UFL_F() == Faces::L) MaskOLL |= 0x0100u; // Reference: UFR_F
+			if (C.GetFace_UFL_U() == Faces::L) MaskOLL |= 0x0200u; // Reference: UFR_R
+			if (C.GetFace_DFL_F() == Faces::L) MaskOLL |= 0x0400u; // Reference: UFL_F
+			if (C.GetFace_DFL_D() == Faces::L) MaskOLL |= 0x0800u; // Reference: UFL_L
+			if (C.GetFace_UBL_B() == Faces::L) MaskOLL |= 0x1000u; // Reference: UBR_B
+			if (C.GetFace_UBL_U() == Faces::L) MaskOLL |= 0x2000u; // Reference: UBR_R
+			if (C.GetFace_DBL_B() == Faces::L) MaskOLL |= 0x4000u; // Reference: UBL_B
+			if (C.GetFace_DBL_D() == Faces::L) MaskOLL |= 0x8000u; // Reference: UBL_L
 			break;
 		case Layers::L: // z' as first inspection turn
-			if (CubeF2L.GetFace_FR_R() == Faces::R) MaskOLL |= 0x0001u; // Reference: UF_U
-			if (CubeF2L.GetFace_BR_R() == Faces::R) MaskOLL |= 0x0002u; // Reference: UB_U
-			if (CubeF2L.GetFace_DR_R() == Faces::R) MaskOLL |= 0x0004u; // Reference: UR_U
-			if (CubeF2L.GetFace_UR_R() == Faces::R) MaskOLL |= 0x0008u; // Reference: UL_U
-			if (CubeF2L.GetFace_DFR_R() == Faces::R) MaskOLL |= 0x0010u; // Reference: UFR_U
-			if (CubeF2L.GetFace_UFR_R() == Faces::R) MaskOLL |= 0x0020u; // Reference: UFL_U
-			if (CubeF2L.GetFace_DBR_R() == Faces::R) MaskOLL |= 0x0040u; // Reference: UBR_U
-			if (CubeF2L.GetFace_UBR_R() == Faces::R) MaskOLL |= 0x0080u; // Reference: UBL_U
-			if (CubeF2L.GetFace_DFR_F() == Faces::R) MaskOLL |= 0x0100u; // Reference: UFR_F
-			if (CubeF2L.GetFace_DFR_D() == Faces::R) MaskOLL |= 0x0200u; // Reference: UFR_R
-			if (CubeF2L.GetFace_UFR_F() == Faces::R) MaskOLL |= 0x0400u; // Reference: UFL_F
-			if (CubeF2L.GetFace_UFR_U() == Faces::R) MaskOLL |= 0x0800u; // Reference: UFL_L
-			if (CubeF2L.GetFace_DBR_B() == Faces::R) MaskOLL |= 0x1000u; // Reference: UBR_B
-			if (CubeF2L.GetFace_DBR_D() == Faces::R) MaskOLL |= 0x2000u; // Reference: UBR_R
-			if (CubeF2L.GetFace_UBR_B() == Faces::R) MaskOLL |= 0x4000u; // Reference: UBL_B
-			if (CubeF2L.GetFace_UBR_U() == Faces::R) MaskOLL |= 0x8000u; // Reference: UBL_L
+			if (C.GetFace_FR_R() == Faces::R) MaskOLL |= 0x0001u; // Reference: UF_U
+			if (C.GetFace_BR_R() == Faces::R) MaskOLL |= 0x0002u; // Reference: UB_U
+			if (C.GetFace_DR_R() == Faces::R) MaskOLL |= 0x0004u; // Reference: UR_U
+			if (C.GetFace_UR_R() == Faces::R) MaskOLL |= 0x0008u; // Reference: UL_U
+			if (C.GetFace_DFR_R() == Faces::R) MaskOLL |= 0x0010u; // Reference: UFR_U
+			if (C.GetFace_UFR_R() == Faces::R) MaskOLL |= 0x0020u; // Reference: UFL_U
+			if (C.GetFace_DBR_R() == Faces::R) MaskOLL |= 0x0040u; // Reference: UBR_U
+			if (C.GetFace_UBR_R() == Faces::R) MaskOLL |= 0x0080u; // Reference: UBL_U
+			if (C.GetFace_DFR_F() == Faces::R) MaskOLL |= 0x0100u; // Reference: UFR_F
+			if (C.GetFace_DFR_D() == Faces::R) MaskOLL |= 0x0200u; // Reference: UFR_R
+			if (C.GetFace_UFR_F() == Faces::R) MaskOLL |= 0x0400u; // Reference: UFL_F
+			if (C.GetFace_UFR_U() == Faces::R) MaskOLL |= 0x0800u; // Reference: UFL_L
+			if (C.GetFace_DBR_B() == Faces::R) MaskOLL |= 0x1000u; // Reference: UBR_B
+			if (C.GetFace_DBR_D() == Faces::R) MaskOLL |= 0x2000u; // Reference: UBR_R
+			if (C.GetFace_UBR_B() == Faces::R) MaskOLL |= 0x4000u; // Reference: UBL_B
+			if (C.GetFace_UBR_U() == Faces::R) MaskOLL |= 0x8000u; // Reference: UBL_L
 			break;
 		default: break;
 		}
 
-		if (MaskOLL == 0u) return false; // Can`t get mask
+		return MaskOLL;
+	}
 
-		// Determine OLL case and PLL turn
-		uint OLL_Index;
-		for (OLL_Index = 0u; OLL_Index < 58u; OLL_Index++)
-		{
-			if (OLL_Masks[0][OLL_Index] == MaskOLL || 
-			    OLL_Masks[1][OLL_Index] == MaskOLL || 
-			    OLL_Masks[2][OLL_Index] == MaskOLL || 
-			    OLL_Masks[3][OLL_Index] == MaskOLL) { OLLCase = static_cast<OLL>(OLL_Index); break; }
-		}
-		if (OLL_Index == 58u) return false; // No OLL case found
+	// Get the OLL recognition table (case and turn before the OLL algorithm for each mask), built in the first use
+	const std::vector<CFOP::OLLEntry>& CFOP::GetOLLTable()
+	{
+		static const std::vector<OLLEntry> OLLTable = BuildOLLTable();
+		return OLLTable;
+	}
 
-        // Get the OLL algorithm
-        Solve_OLL = OLL_Algorithms[static_cast<uint>(OLLCase)][0]; // Only use the first algorithms in the array
+	// Build the OLL recognition table
+	std::vector<CFOP::OLLEntry> CFOP::BuildOLLTable()
+	{
+		std::vector<OLLEntry> OLLTable(0x10000u, OLLEntry{ 58u, Steps::NONE, false });
 
-        // Get the turn that must be done before applying OLL algorithm
-		for (uint Turn_Index = 0u; Turn_Index < 4u; Turn_Index++)
-		{
-			if 		(Turn_Index == 0u) Turn_OLL = Steps::NONE;
-			else if (Turn_Index == 1u) Turn_OLL = Steps::y;
-			else if (Turn_Index == 2u) Turn_OLL = Steps::y2;
-			else 					   Turn_OLL = Steps::yp;
+		// First case with the mask in any orientation (same order as a sequential masks scan)
+		for (uint OLL_Index = 0u; OLL_Index < 58u; OLL_Index++)
+			for (uint n = 0u; n < 4u; n++)
+				if (OLLTable[OLL_Masks[n][OLL_Index]].Case == 58u) OLLTable[OLL_Masks[n][OLL_Index]].Case = OLL_Index;
 
-			CubeOLL = CubeF2L;
-			CubeOLL.ApplyStep(Turn_OLL);
-			CubeOLL.ApplyAlgorithm(Solve_OLL);
+		// Last layer orientation states for all cases (cross in D layer, OLL inverted algorithm and AUF applied to a solved cube)
+		const Steps AUFSteps[4] = { Steps::NONE, Steps::U, Steps::U2, Steps::Up };
+		const Steps Turns[4] = { Steps::NONE, Steps::y, Steps::y2, Steps::yp };
+		std::vector<bool> Done(0x10000u, false);
 
-            if (IsLastLayerOriented())
-            {
-                auto time_OLL_end = std::chrono::system_clock::now();
-                std::chrono::duration<double> OLL_elapsed_seconds = time_OLL_end - time_OLL_start;
-                OLLTime = OLL_elapsed_seconds.count();
+		for (uint OLL_Index = 0u; OLL_Index < 58u; OLL_Index++)
+		{
+			Algorithm Inverse = OLL_Algorithms[OLL_Index][0].GetDeveloped(false);
+			Inverse.TransformReverseInvert();
 
-                return true; // OLL found
-            }
+			for (const auto AUF : AUFSteps)
+			{
+				Cube CubeLL(Inverse);
+				CubeLL.SetSpin(Spins::Default); // Undo the net rotation of the algorithm (the cube is searched without turns)
+				CubeLL.ApplyStep(AUF);
+				const M16 MaskOLL = GetOLLMask(CubeLL, Layers::D);
+				if (Done[MaskOLL] || OLLTable[MaskOLL].Case == 58u) continue;
+				Done[MaskOLL] = true;
+
+				// Get the turn that must be done before applying the OLL algorithm (the result only depends on the mask)
+				Algorithm Solve = OLL_Algorithms[OLLTable[MaskOLL].Case][0];
+				for (const auto T : Turns)
+				{
+					Cube CubeCheck = CubeLL;
+					CubeCheck.ApplyStep(T);
+					CubeCheck.ApplyAlgorithm(Solve);
+					if (CubeCheck.IsLayerOriented(Layers::U)) { OLLTable[MaskOLL].Turn = T; OLLTable[MaskOLL].Valid = true; break; }
+				}
+			}
 		}
 
-		return false; // OLL not found
+		return OLLTable;
 	}
 
 	// Permutation of last layer search
@@ -5341,7 +5926,7 @@ namespace grcube3
 			CubeFinal = CubeOLL;
 			CubeFinal.ApplyStep(Step_AUF);
 			CubeFinal.ApplyStep(Turn_PLL);
-			CubeFinal.ApplyAlgorithm(Solve_PLL);
+			CubeFinal.ApplyTransform(GetPLLTransforms(CubeFinal.GetSpin())[static_cast<uint>(PLLCase)]); // Precompiled PLL algorithm
 
             if (CubeFinal.IsSolved())
             {
@@ -5363,70 +5948,134 @@ namespace grcube3
 
         if (!IsF2LSolved()) return false; // No F2L
 
-        Case1LLL = 1u;
-        bool Found1LLL = false;
+        // Look for the last layer state in the index (the cube spin is the inspection turn)
+        const std::vector<Entry1LLL>& Index1LLL = Get1LLLIndex(CubeF2L.GetSpin());
+        const Entry1LLL Key = { CubeF2L.GetEdgesStatus(), CubeF2L.GetCornersStatus(), 0u };
+        auto Entry = std::lower_bound(Index1LLL.begin(), Index1LLL.end(), Key);
 
-        for (auto &Alg1LLL : Algorithms_1LLL)
+        if (Entry == Index1LLL.end() || Entry->Edges != Key.Edges || Entry->Corners != Key.Corners)
         {
-            // Get the turn that must be done before applying 1LLL algorithm
-            for (uint Turn_Index = 0u; Turn_Index < 4u; Turn_Index++)
-            {
-                if 		(Turn_Index == 0u) Turn_1LLL = Steps::NONE;
-                else if (Turn_Index == 1u) Turn_1LLL = Steps::y;
-                else if (Turn_Index == 2u) Turn_1LLL = Steps::y2;
-                else 					   Turn_1LLL = Steps::yp;
+            Case1LLL = static_cast<uint>(Algorithms_1LLL.size()) + 1u;
+            return false; // 1LLL not found
+        }
 
-                Cube1LLL = CubeF2L;
-                Cube1LLL.ApplyStep(Turn_1LLL);
-                Cube1LLL.ApplyAlgorithm(Alg1LLL);
+        Case1LLL = Entry->Order / 16u + 1u;
+        Turn_1LLL = Turns_1LLL[(Entry->Order >> 2) & 3u];
+        Step_AUF = AUFs_1LLL[Entry->Order & 3u];
+        Solve_1LLL = Algorithms_1LLL[Case1LLL - 1u]; // Get the 1LLL algorithm
 
-                if (Cube1LLL.IsSolved())
-                {
-                    Step_AUF = Steps::NONE;
-                    Found1LLL = true;
-                }
-                else
-                {
-                    Cube1LLL.U();
-                    if (Cube1LLL.IsSolved())
-                    {
-                        Step_AUF = Steps::U;
-                        Found1LLL = true;
-                    }
-                    else
-                    {
-                        Cube1LLL.U();
-                        if (Cube1LLL.IsSolved())
-                        {
-                            Step_AUF = Steps::U2;
-                            Found1LLL = true;
-                        }
-                        else
-                        {
-                            Cube1LLL.U();
-                            if (Cube1LLL.IsSolved())
-                            {
-                                Step_AUF = Steps::Up;
-                                Found1LLL = true;
-                            }
-                        }
-                    }
-                }
+        Cube1LLL = CubeF2L;
+        Cube1LLL.ApplyStep(Turn_1LLL);
+        Cube1LLL.ApplyTransform(Get1LLLTransforms(Cube1LLL.GetSpin())[Case1LLL - 1u]); // Precompiled 1LLL algorithm
+        Cube1LLL.ApplyStep(Step_AUF);
+
+        auto time_1LLL_end = std::chrono::system_clock::now();
+        std::chrono::duration<double> elapsed_seconds_1LLL = time_1LLL_end - time_1LLL_start;
+        Time1LLL = elapsed_seconds_1LLL.count();
+
+        return true; // 1LLL found
+    }
+
+    // Precompile the given algorithms for cubes with the given spin
+    std::vector<CubeTransform> CFOP::CompileAlgorithms(const std::vector<Algorithm>& Algs, const Spins Sp)
+    {
+        std::vector<CubeTransform> Transforms;
+        for (auto A : Algs) Transforms.push_back(Cube::GetTransform(A, Sp));
+        return Transforms;
+    }
+
+    // Get the precompiled OLL algorithms (first algorithm for each case) for the given spin, built in the first use
+    const std::vector<CubeTransform>& CFOP::GetOLLTransforms(const Spins Sp)
+    {
+        static std::vector<CubeTransform> TransformsOLL[24];
+        static std::once_flag FlagsOLL[24];
+
+        const uint s = static_cast<uint>(Sp);
+        std::call_once(FlagsOLL[s], [s]
+        {
+            std::vector<Algorithm> Algs;
+            for (const auto& A : OLL_Algorithms) Algs.push_back(A[0]);
+            TransformsOLL[s] = CompileAlgorithms(Algs, static_cast<Spins>(s));
+        });
+        return TransformsOLL[s];
+    }
+
+    // Get the precompiled PLL algorithms (first algorithm for each case) for the given spin, built in the first use
+    const std::vector<CubeTransform>& CFOP::GetPLLTransforms(const Spins Sp)
+    {
+        static std::vector<CubeTransform> TransformsPLL[24];
+        static std::once_flag FlagsPLL[24];
+
+        const uint s = static_cast<uint>(Sp);
+        std::call_once(FlagsPLL[s], [s]
+        {
+            std::vector<Algorithm> Algs;
+            for (const auto& A : PLL_Algorithms) Algs.push_back(A[0]);
+            TransformsPLL[s] = CompileAlgorithms(Algs, static_cast<Spins>(s));
+        });
+        return TransformsPLL[s];
+    }
+
+    // Get the precompiled 1LLL algorithms for the given spin, built in the first use
+    const std::vector<CubeTransform>& CFOP::Get1LLLTransforms(const Spins Sp)
+    {
+        static std::vector<CubeTransform> Transforms1LLL[24];
+        static std::once_flag Flags1LLL[24];
+
+        const uint s = static_cast<uint>(Sp);
+        std::call_once(Flags1LLL[s], [s] { Transforms1LLL[s] = CompileAlgorithms(Algorithms_1LLL, static_cast<Spins>(s)); });
+        return Transforms1LLL[s];
+    }
+
+    // Get the 1LLL index for the given start spin, built in the first use
+    const std::vector<CFOP::Entry1LLL>& CFOP::Get1LLLIndex(const Spins Sp)
+    {
+        static std::vector<Entry1LLL> Indexes1LLL[24];
+        static std::once_flag Flags1LLL[24];
+
+        const uint s = static_cast<uint>(Sp);
+        std::call_once(Flags1LLL[s], [s] { Indexes1LLL[s] = Build1LLLIndex(static_cast<Spins>(s)); });
+        return Indexes1LLL[s];
+    }
+
+    // Build the 1LLL index for the given start spin: for each algorithm, turn and AUF, the state solved by them
+    // The state is get applying the inverted sequence to a solved cube (in the sequence end spin)
+    std::vector<CFOP::Entry1LLL> CFOP::Build1LLLIndex(const Spins Sp)
+    {
+        std::vector<Entry1LLL> Index1LLL;
+        Index1LLL.reserve(Algorithms_1LLL.size() * 16u);
+
+        for (uint n = 0u; n < Algorithms_1LLL.size(); n++)
+        {
+            Algorithm Alg1LLL = Algorithms_1LLL[n].GetDeveloped(false);
 
-                if (Found1LLL)
+            for (uint t = 0u; t < 4u; t++)
+                for (uint a = 0u; a < 4u; a++)
                 {
-                    Solve_1LLL = Algorithms_1LLL[Case1LLL - 1u]; // Get the 1LLL algorithm
+                    Algorithm Sequence;
+                    Sequence.Append(Turns_1LLL[t]);
+                    Sequence.Append(Alg1LLL);
+                    Sequence.Append(AUFs_1LLL[a]);
+
+                    Cube CubeEnd; // Get the spin at the end of the sequence
+                    CubeEnd.SetSpin(Sp);
+                    CubeEnd.ApplyAlgorithm(Sequence);
 
-                    auto time_1LLL_end = std::chrono::system_clock::now();
-                    std::chrono::duration<double> elapsed_seconds_1LLL = time_1LLL_end - time_1LLL_start;
-                    Time1LLL = elapsed_seconds_1LLL.count();
+                    Sequence.TransformReverseInvert();
+                    Cube CubeStart;
+                    CubeStart.SetSpin(CubeEnd.GetSpin());
+                    CubeStart.ApplyAlgorithm(Sequence);
 
-                    return true; // 1LLL found
+                    Index1LLL.push_back({ CubeStart.GetEdgesStatus(), CubeStart.GetCornersStatus(), (n << 4) | (t << 2) | a });
                 }
-            }
-            Case1LLL++;
         }
-        return false; // 1LLL not found
+
+        // Sort by state, for repeated states only the first one in search order (algorithm, turn, AUF) is kept
+        std::sort(Index1LLL.begin(), Index1LLL.end());
+        Index1LLL.erase(std::unique(Index1LLL.begin(), Index1LLL.end(),
+                                    [](const Entry1LLL& E1, const Entry1LLL& E2) { return E1.Edges == E2.Edges && E1.Corners == E2.Corners; }),
+                        Index1LLL.end());
+        return Index1LLL;
     }
 
 	// Get the layer with the best solve score
@@ -5463,6 +6112,7 @@ namespace grcube3
         if (!IsCrossSolved())
         {
             Report += "Cross not solved in " + std::to_string(GetLastCrossDeep()) + " movements!\n";
+            if (IsInterrupted()) Report += "Search interrupted!\n";
             Report += "Search time: " + std::to_string(GetFullTime()) + " s\n";
             return Report;
         }
@@ -5486,6 +6136,7 @@ namespace grcube3
         if (!IsF2LSolved())
         {
             Report += "F2L not solved!\n";
+            if (IsInterrupted()) Report += "Search interrupted!\n";
             Report += "Search time: " + std::to_string(GetFullTime()) + " s\n";
             return Report;
         }
@@ -32,7 +32,11 @@ namespace grcube3
 	{
 	public:
 		// Constructor with cube scramble
-		CFOP(const Algorithm& Scr, int NumCores = 0) { Scramble = Scr; CubeBase = Cube(Scramble); Reset(); Cores = NumCores; }
+		CFOP(const Algorithm& Scr, int NumCores = 0)
+		{
+			Scramble = Scr; CubeBase = Cube(Scramble); Reset(); Cores = NumCores;
+			Cancel = nullptr; Deadline = std::chrono::steady_clock::time_point::max(); Interrupted = F2LInterrupted = false;
+		}
 
 		// Destructor
 		~CFOP() {}
@@ -40,16 +44,36 @@ namespace grcube3
 		// Reset the search results
 		void Reset();
 
+		// Time limit for the full solve (seconds from now, 0 for no limit)
+		// The cross search can use a part of the remaining time, the F2L searches use the rest of the time
+		void SetTimeLimit(const double);
+
+		// Cancellation token to stop the searches from other thread (nullptr for none)
+		void SetCancel(const SearchCancel* C) { Cancel = C; }
+
+		// Check if a search has been cut short by the time limit or the cancellation token (the solve is partial)
+		bool IsInterrupted() const { return Interrupted; }
+
 		// Search the best cross solve algorithm with the given search deep for the crosses pieces groups
 		// Return false if no cross found
 		bool SearchCross(const uint, const std::vector<PiecesGroups>&);
 
+		// Search the shortest XCross (cross and a F2L pair) within the given number of movements for the crosses pieces groups,
+		// or the shortest XXCross (cross and two F2L pairs) if requested, with the XCross pruning table. The solve is used as
+		// the cross solve. Return false if no XCross found
+		bool SearchXCross(const uint, const std::vector<PiecesGroups>&, const bool = false);
+
 		// Search the best F2L 'Solves' algorithms for the 'Scramble'.
         bool SearchF2L()
         {
             auto time_F2L_start = std::chrono::system_clock::now();
+            F2LNodes = 0ull;
+            F2LStats = SearchStats();
+            F2LInterrupted = false;
+            for (auto& Seed : Solve_F2L_Seeds) Seed.Clear(); // No previous slot solves
 
-            while(!SearchF2LStep()); // Repeat until returns true
+            // Repeat until returns true (or the F2L search is cut short, or there is no time left)
+            while(!SearchF2LStep() && !F2LInterrupted && !IsLimitReached());
 
             auto time_F2L_end = std::chrono::system_clock::now();
             std::chrono::duration<double> F2L_elapsed_seconds = time_F2L_end - time_F2L_start;
@@ -58,6 +82,12 @@ namespace grcube3
             return IsF2LSolved();
         }
 
+		// Search the F2L 'Solves' algorithms with the F2L cases table: the corner and edge pair case of each slot is recognized
+		// (with the AUF before the algorithm) and solved with the stored algorithm. Much faster than SearchF2L, but the solves
+		// are longer. If no pair can be recognized (the pair pieces are in other slots), a F2L search step is done when the
+		// search fallback is enabled, else the pieces are taken out of the slot
+		bool SearchF2LCases(const bool = false);
+
 		// Orientation of last layer search
 		bool SearchOLL();
 
@@ -106,6 +136,9 @@ namespace grcube3
 		// Check if final cube is solved
         bool IsSolved() const { return CubeFinal.IsSolved(); }
 
+		// Check if the cube is solved with the 1LLL search
+        bool Is1LLLSolved() const { return Cube1LLL.IsSolved(); }
+
 		// Returns the current cross layer ('U', 'D', 'F', 'B', 'R' or 'L').
 		Layers GetCrossLayer() const { return CrossLayer; }
 
@@ -204,6 +237,17 @@ namespace grcube3
         // Get the time elapsed searching 1LLL
         double Get1LLLTime() const { return Time1LLL; }
 
+        // Get the search nodes visited searching cross
+        S64 GetCrossNodes() const { return CrossNodes; }
+
+        // Get the search nodes visited searching F2L
+        S64 GetF2LNodes() const { return F2LNodes; }
+
+        // Get the search statistics for the cross and for the F2L (all F2L searches added)
+        // Levels counters are only collected if GRCUBE_SEARCH_STATS is defined
+        const SearchStats& GetCrossStats() const { return CrossStats; }
+        const SearchStats& GetF2LStats() const { return F2LStats; }
+
         // Get the time for the full search
         double GetFullTime() const { return CrossTime + F2LTime + (Case1LLL == 0 ?  (OLLTime + PLLTime) : Time1LLL); }
 
@@ -214,6 +258,7 @@ namespace grcube3
 		int GetUsedCores() const { return Cores; }
 
 	private:
+		friend struct CFOPTests; // Consistency checks over the internal tables (cfop_tests)
 		
 		Algorithm Scramble, // Cube scramble
                   Solve_Cross, // Algorithm for the cross solve
@@ -227,7 +272,8 @@ namespace grcube3
 			      Solve_F2L_4, // Auxiliary algorithm for solve fourth F2L pair
 			      Solve_OLL, // Algorithm to apply for OLL solve
                   Solve_PLL, // Algorithm to apply for PLL solve
-                  Solve_1LLL; // Algorithm to apply for 1LLL solve
+                  Solve_1LLL, // Algorithm to apply for 1LLL solve
+                  Solve_F2L_Seeds[4]; // Best solve for each F2L slot in the last F2L search step (to bound the next slot searches)
 
 		Steps Turn_Inspection, // Turn for inspection
 			  Turn_PLL, // Turn for PLL
@@ -256,14 +302,83 @@ namespace grcube3
         // Times
         double CrossTime, F2LTime, OLLTime, PLLTime, Time1LLL;
 
+        // Search nodes visited
+        S64 CrossNodes, F2LNodes;
+
+        // Search statistics
+        SearchStats CrossStats, F2LStats;
+
 		// Cores to use in the search: -1 = no multithreading, 0 = all avaliable cores, other = use this amount of cores
 		int Cores;
 
+        // Search limits
+        const SearchCancel* Cancel; // Cancellation token (nullptr if not used)
+        std::chrono::steady_clock::time_point Deadline; // Time to stop the searches (max if not used)
+        bool Interrupted; // A search has been cut short (for the report, each stage checks its own searches)
+        bool F2LInterrupted; // A F2L search has been cut short in the current F2L stage
+        static constexpr double CROSS_TIME_SHARE = 0.5; // Part of the remaining time for the cross search
+
+        // Check if the solve has been cancelled or the time limit has been reached
+        bool IsLimitReached() const
+        {
+            return (Cancel != nullptr && Cancel->IsCancelled()) ||
+                   (Deadline != std::chrono::steady_clock::time_point::max() && std::chrono::steady_clock::now() >= Deadline);
+        }
+
+        // Apply the search limits to a search, using the given part of the remaining time
+        void SetSearchLimits(DeepSearch&, const double = 1.0) const;
+
         // Returns true if the search is complete. If returns false, call this function again.
         bool SearchF2LStep();
 
+		// XCross search data: the cube is rotated for each cross layer and F2L slot to use the XCross pruning table
+		struct XCrossData
+		{
+			const XCrossPruningTable* Table; // XCross pruning table
+			uint Slots; // Number of rotated cubes (four F2L slots for each cross layer)
+			uint Pairs; // F2L pairs to solve with the cross
+			std::vector<Steps> SlotSteps; // Movement for each rotated cube and movement
+			std::vector<Cube> Cubes; // Rotated cubes for each level
+			std::vector<Steps> Path; // Movement for each level
+			std::chrono::steady_clock::time_point Deadline; // Time to stop the search
+			S64 Nodes; // Nodes searched
+		};
+		// Movements needed for the XCross (or XXCross) in the best cross layer of the given level (and the layer index)
+		static uint GetXCrossDistance(const XCrossData&, const uint, uint&);
+		// Check if the cross and the needed F2L pairs are solved in the given cross layer index of the given level
+		static bool IsXCrossSolved(const XCrossData&, const uint, const uint);
+		// XCross depth-first search from the given level to the given deep, returns the solved cross layer index (layers number if not solved)
+		uint SearchXCrossLevel(XCrossData&, const uint, const uint);
+
+		// Static array with F2L solve algorithms (by case), for the front right pair with the cross in the down layer
+		const static std::vector<Algorithm> F2L_Algorithms[41];
+		// F2L recognition table entry: F2L case, AUF step to do before the F2L algorithm and solve length (AUF included)
+		struct F2LEntry { uint Case; Steps AUF; uint Length; bool Valid; };
+		// Get the F2L recognition table (an entry for each position of the corner D sticker and the edge F sticker of the
+		// front right pair), built in the first use
+		static const std::vector<F2LEntry>& GetF2LTable();
+		static std::vector<F2LEntry> BuildF2LTable();
+		// Get the F2L recognition table index for the front right pair of the given cube (cross in the down layer)
+		static uint GetF2LIndex(const Cube& C)
+		{
+			return (static_cast<uint>(C.GetStickerPosition(Stickers::DFR_D)) - static_cast<uint>(StickerPositions::First_Corner)) * 24u +
+				    static_cast<uint>(C.GetStickerPosition(Stickers::FR_F)) - static_cast<uint>(StickerPositions::First_Edge);
+		}
+		// Rotation that moves a F2L slot to the front right slot with the cross in the down layer, and the inverse rotation
+		struct F2LSymmetry { uint Sym, Inverse; };
+		// Get the F2L slots rotations (for each cross layer, the slots in the DeepSearch::GetF2LPiecesGroups order), built in the first use
+		static const std::vector<F2LSymmetry>& GetF2LSymmetries();
+		static std::vector<F2LSymmetry> BuildF2LSymmetries();
+
 		// Static Array with all possible OLL masks (58 possibilities in 4 orientations).
 		const static M16 OLL_Masks[4][58];
+		// OLL recognition table entry: OLL case (58 if no case) and turn to do before the OLL algorithm
+		struct OLLEntry { uint Case; Steps Turn; bool Valid; };
+		// Get the OLL recognition table (an entry for each OLL mask), built in the first use
+		static const std::vector<OLLEntry>& GetOLLTable();
+		static std::vector<OLLEntry> BuildOLLTable();
+		// Get the mask for OLL from the given cube with the given cross layer
+		static M16 GetOLLMask(const Cube&, const Layers);
 
 		// Static Array with all possible PLL masks (22 possibilities in 4 orientations).
 		const static M16 PLL_Masks[4][22];
@@ -276,6 +391,23 @@ namespace grcube3
 
         // Static array with 1LLL solve algorithms
         static std::vector<Algorithm> Algorithms_1LLL;
+        // Turns and AUF steps for 1LLL, in search order
+        const static Steps Turns_1LLL[4], AUFs_1LLL[4];
+        // 1LLL index entry: last layer state (edges and corners) and the first algorithm, turn and AUF that solves it
+        struct Entry1LLL
+        {
+            S64 Edges, Corners;
+            uint Order; // Algorithm index * 16 + turn index * 4 + AUF index
+            bool operator<(const Entry1LLL& E) const { return Edges != E.Edges ? Edges < E.Edges : Corners != E.Corners ? Corners < E.Corners : Order < E.Order; }
+        };
+        // Precompiled OLL, PLL and 1LLL algorithms (same order as the algorithms tables) for the given start spin, built in the first use
+        static const std::vector<CubeTransform>& GetOLLTransforms(const Spins);
+        static const std::vector<CubeTransform>& GetPLLTransforms(const Spins);
+        static const std::vector<CubeTransform>& Get1LLLTransforms(const Spins);
+        static std::vector<CubeTransform> CompileAlgorithms(const std::vector<Algorithm>&, const Spins);
+        // Get the 1LLL index (sorted by state) for the given start spin, built in the first use
+        static const std::vector<Entry1LLL>& Get1LLLIndex(const Spins);
+        static std::vector<Entry1LLL> Build1LLLIndex(const Spins);
 
 		// Array with OLL cases string representation
 		const static std::string OLL_Strings[58];
@@ -0,0 +1,506 @@
+/*  This file is part of "GR Cube"
+
+	Copyright (C) 2020 German Ramos Rodriguez
+
+	This program is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	This program is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+	German Ramos Rodriguez
+	Vigo, Spain
+	grvigo@hotmail.com
+*/
+
+// CFOP benchmark: runs a versioned corpus of scrambles through all the CFOP stages with the given search depths and threads
+// Results are printed as JSON (per-stage wall time percentiles, nodes per second and solve lengths) and can be compared with a baseline
+// Each stage has a sample only for the scrambles where the stage runs, and the total only for the solved scrambles
+// If GRCUBE_SEARCH_STATS is defined, the cross and F2L search statistics (per level and per thread) are also included
+// Usage: cfop_bench [--corpus <file>] [--depths 5,6] [--threads 0,1] [--ll 2lll|1lll|both] [--f2l search|cases] [--count <n>] [--output <file>] [--baseline <file>] [--tolerance <percent>]
+
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <map>
+#include <algorithm>
+#include <cstdlib>
+#include <cstdio>
+#include <cctype>
+
+#include "cfop.h"
+#include "cube_batch.h"
+
+using namespace grcube3;
+
+namespace
+{
+	const uint BENCH_FORMAT_VERSION = 2u; // Version of the JSON results format
+
+	// Benchmark options
+	struct BenchOptions
+	{
+		std::string CorpusFile = "benchmark/corpus_v1.txt"; // Scrambles corpus
+		std::vector<int> Depths = { 6 }; // Cross search depths
+		std::vector<int> Threads = { 0 }; // Threads for each run (0 = all cores, -1 = no threads)
+		bool Run2LLL = true, Run1LLL = true; // Last layer methods
+		bool F2LCases = false; // F2L cases table instead of F2L search
+		uint Count = 0u; // Number of scrambles to use (0 = all)
+		std::string OutputFile; // JSON output file (standard output if empty)
+		std::string BaselineFile; // Baseline JSON results to compare with
+		double Tolerance = 10.0; // Allowed slowdown against the baseline (percent)
+	};
+
+	// Samples for a stage (one per scramble)
+	struct StageSamples
+	{
+		std::vector<double> Times; // Wall times (seconds), only for the scrambles where the stage runs
+		S64 Nodes = 0ull; // Search nodes visited
+	};
+
+	// Results for a run (a depth, threads and last layer method combination)
+	struct RunResult
+	{
+		std::string Name; // Run identifier, to compare with the baseline
+		int Depth, Threads;
+		std::string LL; // "2lll" or "1lll"
+		std::string F2L; // "search" or "cases"
+		uint Solved = 0u; // Solved scrambles
+		std::vector<std::string> StageNames; // Stages in order
+		std::map<std::string, StageSamples> Stages; // Samples for each stage
+		std::vector<double> Lengths; // Solve lengths (solved scrambles only)
+		SearchStats CrossStats, F2LStats; // Search statistics for all the scrambles (only with GRCUBE_SEARCH_STATS)
+	};
+
+	// Minimal JSON value, enough to read the benchmark results
+	struct JsonValue
+	{
+		enum class Types { NONE, NUMBER, STRING, BOOLEAN, ARRAY, OBJECT } Type = Types::NONE;
+		double Number = 0.0;
+		std::string String;
+		bool Boolean = false;
+		std::vector<JsonValue> Array;
+		std::vector<std::pair<std::string, JsonValue>> Object;
+
+		// Get an object member (nullptr if not found)
+		const JsonValue* Get(const std::string& Key) const
+		{
+			for (const auto& M : Object) if (M.first == Key) return &M.second;
+			return nullptr;
+		}
+	};
+
+	// Minimal JSON parser
+	class JsonParser
+	{
+	public:
+		JsonParser(const std::string& T) : Text(T), Pos(0u) {}
+
+		bool Parse(JsonValue& V) { return ParseValue(V) && (SkipSpaces(), Pos == Text.size()); }
+
+	private:
+		const std::string Text;
+		size_t Pos;
+
+		void SkipSpaces() { while (Pos < Text.size() && std::isspace(static_cast<unsigned char>(Text[Pos]))) Pos++; }
+		bool Match(const char C) { SkipSpaces(); if (Pos < Text.size() && Text[Pos] == C) { Pos++; return true; } return false; }
+
+		bool ParseString(std::string& S)
+		{
+			if (!Match('"')) return false;
+			S.clear();
+			while (Pos < Text.size() && Text[Pos] != '"')
+			{
+				if (Text[Pos] == '\\' && Pos + 1u < Text.size()) Pos++;
+				S += Text[Pos++];
+			}
+			return Pos++ < Text.size();
+		}
+
+		bool ParseValue(JsonValue& V)
+		{
+			SkipSpaces();
+			if (Pos >= Text.size()) return false;
+			const char C = Text[Pos];
+			if (C == '{')
+			{
+				Pos++;
+				V.Type = JsonValue::Types::OBJECT;
+				if (Match('}')) return true;
+				do
+				{
+					std::pair<std::string, JsonValue> M;
+					if (!ParseString(M.first) || !Match(':') || !ParseValue(M.second)) return false;
+					V.Object.push_back(M);
+				} while (Match(','));
+				return Match('}');
+			}
+			if (C == '[')
+			{
+				Pos++;
+				V.Type = JsonValue::Types::ARRAY;
+				if (Match(']')) return true;
+				do
+				{
+					JsonValue E;
+					if (!ParseValue(E)) return false;
+					V.Array.push_back(E);
+				} while (Match(','));
+				return Match(']');
+			}
+			if (C == '"') { V.Type = JsonValue::Types::STRING; return ParseString(V.String); }
+			if (Text.compare(Pos, 4u, "true") == 0) { V.Type = JsonValue::Types::BOOLEAN; V.Boolean = true; Pos += 4u; return true; }
+			if (Text.compare(Pos, 5u, "false") == 0) { V.Type = JsonValue::Types::BOOLEAN; Pos += 5u; return true; }
+			if (Text.compare(Pos, 4u, "null") == 0) { Pos += 4u; return true; }
+
+			char* End = nullptr;
+			V.Number = std::strtod(Text.c_str() + Pos, &End);
+			if (End == Text.c_str() + Pos) return false;
+			V.Type = JsonValue::Types::NUMBER;
+			Pos = static_cast<size_t>(End - Text.c_str());
+			return true;
+		}
+	};
+
+	// Read a comma separated list of integers
+	bool ParseIntList(const std::string& Text, std::vector<int>& Values)
+	{
+		Values.clear();
+		std::stringstream SS(Text);
+		std::string Item;
+		while (std::getline(SS, Item, ','))
+		{
+			char* End = nullptr;
+			const long V = std::strtol(Item.c_str(), &End, 10);
+			if (Item.empty() || *End != '\0') return false;
+			Values.push_back(static_cast<int>(V));
+		}
+		return !Values.empty();
+	}
+
+	// Read the command line options, returns false with an error message if the options are not valid
+	bool ParseOptions(const int argc, char* argv[], BenchOptions& Options, std::string& Error)
+	{
+		for (int n = 1; n < argc; n++)
+		{
+			const std::string Arg = argv[n];
+			if (Arg == "-h" || Arg == "--help") { Error.clear(); return false; }
+			if (n + 1 >= argc) { Error = "Missing value for " + Arg; return false; }
+			const std::string Value = argv[++n];
+
+			if (Arg == "--corpus") Options.CorpusFile = Value;
+			else if (Arg == "--depths")
+			{
+				if (!ParseIntList(Value, Options.Depths)) { Error = "Invalid depths list"; return false; }
+				for (const int D : Options.Depths) if (D < 1 || D > static_cast<int>(SearchPath::MAX_STEPS)) { Error = "Invalid depth"; return false; }
+			}
+			else if (Arg == "--threads")
+			{
+				if (!ParseIntList(Value, Options.Threads)) { Error = "Invalid threads list"; return false; }
+				for (const int T : Options.Threads) if (T < -1) { Error = "Invalid threads number"; return false; }
+			}
+			else if (Arg == "--ll")
+			{
+				if (Value != "2lll" && Value != "1lll" && Value != "both") { Error = "Invalid last layer method"; return false; }
+				Options.Run2LLL = Value != "1lll";
+				Options.Run1LLL = Value != "2lll";
+			}
+			else if (Arg == "--f2l")
+			{
+				if (Value != "search" && Value != "cases") { Error = "Invalid F2L method"; return false; }
+				Options.F2LCases = Value == "cases";
+			}
+			else if (Arg == "--count") Options.Count = static_cast<uint>(std::strtoul(Value.c_str(), nullptr, 10));
+			else if (Arg == "--output") Options.OutputFile = Value;
+			else if (Arg == "--baseline") Options.BaselineFile = Value;
+			else if (Arg == "--tolerance") Options.Tolerance = std::strtod(Value.c_str(), nullptr);
+			else { Error = "Unknown option: " + Arg; return false; }
+		}
+		return true;
+	}
+
+	// Read the corpus scrambles and version (lines starting with '#' are comments, "# version: n" gives the corpus version)
+	bool ReadCorpus(const std::string& File, std::vector<std::string>& Scrambles, std::string& Version)
+	{
+		std::ifstream In(File);
+		if (!In) return false;
+		std::string Line;
+		while (std::getline(In, Line))
+		{
+			if (!Line.empty() && Line.back() == '\r') Line.pop_back();
+			if (Line.empty()) continue;
+			if (Line[0] == '#')
+			{
+				const size_t p = Line.find("version:");
+				if (p != std::string::npos) Version = Line.substr(Line.find_first_not_of(' ', p + 8u));
+				continue;
+			}
+			Scrambles.push_back(Line);
+		}
+		return true;
+	}
+
+	// Value in the given percentile (nearest rank) of sorted samples
+	double Percentile(const std::vector<double>& Sorted, const double P)
+	{
+		if (Sorted.empty()) return 0.0;
+		size_t Rank = static_cast<size_t>(P / 100.0 * static_cast<double>(Sorted.size()) + 0.999999);
+		if (Rank < 1u) Rank = 1u;
+		if (Rank > Sorted.size()) Rank = Sorted.size();
+		return Sorted[Rank - 1u];
+	}
+
+	// Samples statistics as JSON members
+	std::string StatsJson(std::vector<double> Samples)
+	{
+		std::sort(Samples.begin(), Samples.end());
+		double Sum = 0.0;
+		for (const double S : Samples) Sum += S;
+		char Buffer[256];
+		std::snprintf(Buffer, sizeof(Buffer), "\"mean\":%.6f,\"p50\":%.6f,\"p90\":%.6f,\"p99\":%.6f,\"max\":%.6f",
+					  Samples.empty() ? 0.0 : Sum / static_cast<double>(Samples.size()),
+					  Percentile(Samples, 50.0), Percentile(Samples, 90.0), Percentile(Samples, 99.0), Samples.empty() ? 0.0 : Samples.back());
+		return Buffer;
+	}
+
+	// Search statistics as a JSON object
+	std::string SearchStatsJson(const SearchStats& S)
+	{
+		std::stringstream Out;
+		Out << "{\"levels\": [";
+		for (size_t level = 0u; level < S.Levels.size(); level++)
+		{
+			const LevelStats& L = S.Levels[level];
+			Out << (level > 0u ? ", " : "") << "{\"nodes\": " << L.Nodes << ", \"checks\": " << L.Checks << ", \"pruned\": " << L.Pruned << ", \"transpositions\": " << L.Transpositions << ", \"solves\": " << L.Solves << "}";
+		}
+		Out << "], \"threads_nodes\": [";
+		for (size_t t = 0u; t < S.ThreadsNodes.size(); t++) Out << (t > 0u ? ", " : "") << S.ThreadsNodes[t];
+		Out << "], \"threads_busy_s\": [";
+		for (size_t t = 0u; t < S.ThreadsBusyTime.size(); t++) Out << (t > 0u ? ", " : "") << S.ThreadsBusyTime[t];
+		Out << "], \"time_s\": " << S.Time << "}";
+		return Out.str();
+	}
+
+	// Run all the scrambles with the given configuration
+	RunResult RunBenchmark(const std::vector<std::string>& Scrambles, const int Depth, const int Threads, const bool Use1LLL, const bool F2LCases)
+	{
+		RunResult R;
+		R.Depth = Depth;
+		R.Threads = Threads;
+		R.LL = Use1LLL ? "1lll" : "2lll";
+		R.F2L = F2LCases ? "cases" : "search";
+		R.Name = "depth" + std::to_string(Depth) + "_threads" + std::to_string(Threads) + "_" + R.LL + (F2LCases ? "_f2lcases" : "");
+		R.StageNames = Use1LLL ? std::vector<std::string>{ "cross", "f2l", "1lll", "total" } : std::vector<std::string>{ "cross", "f2l", "oll", "pll", "total" };
+
+		for (const auto& S : R.StageNames) R.Stages[S] = StageSamples(); // All stages in the results, even without samples
+
+		const std::vector<PiecesGroups> Crosses = { PiecesGroups::C_U, PiecesGroups::C_D, PiecesGroups::C_F, PiecesGroups::C_B, PiecesGroups::C_R, PiecesGroups::C_L };
+
+		for (const auto& Text : Scrambles)
+		{
+			Algorithm Scramble(Text.c_str());
+			Scramble = Scramble.GetSimplified();
+			Scramble = Scramble.GetWithoutTurns();
+			while (Scramble.Shrink());
+
+			// Each stage only runs if the previous one is done
+			CFOP SearchCFOP(Scramble, Threads);
+			const bool CrossDone = SearchCFOP.SearchCross(static_cast<uint>(Depth), Crosses);
+			const bool F2LDone = CrossDone && (F2LCases ? SearchCFOP.SearchF2LCases() : SearchCFOP.SearchF2L());
+			bool Solved = false;
+
+			R.Stages["cross"].Times.push_back(SearchCFOP.GetCrossTime());
+			R.Stages["cross"].Nodes += SearchCFOP.GetCrossNodes();
+			if (CrossDone)
+			{
+				R.Stages["f2l"].Times.push_back(SearchCFOP.GetF2LTime());
+				R.Stages["f2l"].Nodes += SearchCFOP.GetF2LNodes();
+			}
+			if (F2LDone)
+			{
+				if (Use1LLL)
+				{
+					Solved = SearchCFOP.Search1LLL() && SearchCFOP.Is1LLLSolved();
+					R.Stages["1lll"].Times.push_back(SearchCFOP.Get1LLLTime());
+				}
+				else
+				{
+					const bool OLLDone = SearchCFOP.SearchOLL();
+					R.Stages["oll"].Times.push_back(SearchCFOP.GetOLLTime());
+					if (OLLDone)
+					{
+						Solved = SearchCFOP.SearchPLL() && SearchCFOP.IsSolved();
+						R.Stages["pll"].Times.push_back(SearchCFOP.GetPLLTime());
+					}
+				}
+			}
+			if (Solved) // The total time is only comparable for complete solves
+			{
+				R.Stages["total"].Times.push_back(SearchCFOP.GetFullTime());
+				R.Stages["total"].Nodes += SearchCFOP.GetCrossNodes() + SearchCFOP.GetF2LNodes();
+			}
+			if (SearchStats::ENABLED)
+			{
+				R.CrossStats.Add(SearchCFOP.GetCrossStats());
+				R.F2LStats.Add(SearchCFOP.GetF2LStats());
+			}
+
+			if (Solved)
+			{
+				R.Solved++;
+				R.Lengths.push_back(static_cast<double>(SearchCFOP.GetLengthSolve()));
+			}
+		}
+		return R;
+	}
+
+	// Ratio between the current and the baseline median times for each stage of a run (empty if the run is not in the baseline)
+	// and the solved scrambles in the baseline run (-1 if the run is not in the baseline)
+	std::map<std::string, double> CompareRun(const RunResult& R, const JsonValue& Baseline, int& BaselineSolved)
+	{
+		std::map<std::string, double> Ratios;
+		BaselineSolved = -1;
+		const JsonValue* Runs = Baseline.Get("runs");
+		if (Runs == nullptr) return Ratios;
+
+		for (const auto& BRun : Runs->Array)
+		{
+			const JsonValue* Name = BRun.Get("name");
+			const JsonValue* BStages = BRun.Get("stages");
+			if (Name == nullptr || BStages == nullptr || Name->String != R.Name) continue;
+			const JsonValue* BSolved = BRun.Get("solved");
+			if (BSolved != nullptr) BaselineSolved = static_cast<int>(BSolved->Number);
+
+			for (const auto& S : R.StageNames)
+			{
+				const JsonValue* BStage = BStages->Get(S);
+				const JsonValue* BP50 = BStage != nullptr ? BStage->Get("p50") : nullptr;
+				if (BP50 == nullptr || BP50->Number <= 0.0) continue;
+				std::vector<double> Times = R.Stages.at(S).Times;
+				std::sort(Times.begin(), Times.end());
+				Ratios[S] = Percentile(Times, 50.0) / BP50->Number;
+			}
+		}
+		return Ratios;
+	}
+}
+
+// Exit code: 0 if the benchmark is done (and no run is slower than the baseline tolerance or solves other number of scrambles),
+// 1 for invalid options or files, 3 for slower runs or runs with other number of solved scrambles
+int main(int argc, char* argv[])
+{
+	BenchOptions Options;
+	std::string Error;
+	if (!ParseOptions(argc, argv, Options, Error))
+	{
+		if (!Error.empty()) std::cerr << "cfop_bench: " << Error << "\n";
+		std::cerr << "Usage: cfop_bench [--corpus <file>] [--depths 5,6] [--threads 0,1] [--ll 2lll|1lll|both] [--f2l search|cases] [--count <n>] "
+					 "[--output <file>] [--baseline <file>] [--tolerance <percent>]\n";
+		return Error.empty() ? 0 : 1;
+	}
+
+	std::vector<std::string> Scrambles;
+	std::string CorpusVersion = "unknown";
+	if (!ReadCorpus(Options.CorpusFile, Scrambles, CorpusVersion) || Scrambles.empty())
+	{
+		std::cerr << "cfop_bench: Can't read the corpus " << Options.CorpusFile << "\n";
+		return 1;
+	}
+	if (Options.Count > 0u && Options.Count < Scrambles.size()) Scrambles.resize(Options.Count);
+
+	JsonValue Baseline;
+	if (!Options.BaselineFile.empty())
+	{
+		std::ifstream In(Options.BaselineFile);
+		std::stringstream SS;
+		SS << In.rdbuf();
+		JsonParser Parser(SS.str());
+		if (!In || !Parser.Parse(Baseline))
+		{
+			std::cerr << "cfop_bench: Can't read the baseline " << Options.BaselineFile << "\n";
+			return 1;
+		}
+	}
+
+	std::vector<RunResult> Results;
+	for (const int D : Options.Depths)
+		for (const int T : Options.Threads)
+		{
+			if (Options.Run2LLL) { Results.push_back(RunBenchmark(Scrambles, D, T, false, Options.F2LCases)); std::cerr << "Run " << Results.back().Name << " done\n"; }
+			if (Options.Run1LLL) { Results.push_back(RunBenchmark(Scrambles, D, T, true, Options.F2LCases)); std::cerr << "Run " << Results.back().Name << " done\n"; }
+		}
+
+	// JSON results
+	bool Regression = false;
+	std::stringstream Out;
+	Out << "{\n  \"format\": " << BENCH_FORMAT_VERSION << ",\n  \"corpus\": {\"file\": \"" << Options.CorpusFile << "\", \"version\": \"" << CorpusVersion
+		<< "\", \"scrambles\": " << Scrambles.size() << "},\n  \"system\": {\"cores\": " << DeepSearch::GetSystemCores()
+		<< ", \"avx2\": " << (CubeBatch::IsAVX2() ? "true" : "false") << "},\n  \"runs\": [";
+	for (size_t r = 0u; r < Results.size(); r++)
+	{
+		const RunResult& R = Results[r];
+		Out << (r > 0u ? "," : "") << "\n    {\"name\": \"" << R.Name << "\", \"depth\": " << R.Depth << ", \"threads\": " << R.Threads
+			<< ", \"ll\": \"" << R.LL << "\", \"f2l\": \"" << R.F2L << "\", \"solved\": " << R.Solved << ",\n     \"stages\": {";
+		for (size_t s = 0u; s < R.StageNames.size(); s++)
+		{
+			const StageSamples& S = R.Stages.at(R.StageNames[s]);
+			double Time = 0.0;
+			for (const double t : S.Times) Time += t;
+			Out << (s > 0u ? "," : "") << "\n       \"" << R.StageNames[s] << "\": {\"samples\": " << S.Times.size() << ", " << StatsJson(S.Times)
+				<< ", \"nodes\": " << S.Nodes << ", \"nodes_per_s\": " << (Time > 0.0 ? static_cast<S64>(static_cast<double>(S.Nodes) / Time) : 0ull) << "}";
+		}
+		Out << "},\n     \"length\": {" << StatsJson(R.Lengths) << "}";
+		if (SearchStats::ENABLED)
+			Out << ",\n     \"search_stats\": {\"cross\": " << SearchStatsJson(R.CrossStats) << ",\n                      \"f2l\": " << SearchStatsJson(R.F2LStats) << "}";
+
+		if (!Options.BaselineFile.empty())
+		{
+			int BaselineSolved;
+			const std::map<std::string, double> Ratios = CompareRun(R, Baseline, BaselineSolved);
+			Out << ",\n     \"baseline_p50_ratio\": {";
+			bool First = true;
+			for (const auto& S : R.StageNames)
+			{
+				if (Ratios.count(S) == 0u) continue;
+				Out << (First ? "" : ", ") << "\"" << S << "\": " << Ratios.at(S);
+				First = false;
+			}
+			Out << "}";
+			if (Ratios.count("total") > 0u)
+			{
+				const double Ratio = Ratios.at("total");
+				std::cerr << R.Name << ": total p50 " << (Ratio >= 1.0 ? "+" : "") << (Ratio - 1.0) * 100.0 << "% against the baseline\n";
+				if (Ratio > 1.0 + Options.Tolerance / 100.0) Regression = true;
+			}
+			else if (BaselineSolved < 0) std::cerr << R.Name << ": not in the baseline\n";
+
+			// The times are only comparable for the same solved scrambles
+			if (BaselineSolved >= 0 && static_cast<uint>(BaselineSolved) != R.Solved)
+			{
+				std::cerr << R.Name << ": " << R.Solved << " solved scrambles, " << BaselineSolved << " in the baseline\n";
+				Regression = true;
+			}
+		}
+		Out << "}";
+	}
+	Out << "\n  ]\n}\n";
+
+	if (Options.OutputFile.empty()) std::cout << Out.str();
+	else
+	{
+		std::ofstream File(Options.OutputFile);
+		File << Out.str();
+		if (!File) { std::cerr << "cfop_bench: Can't write " << Options.OutputFile << "\n"; return 1; }
+	}
+
+	return Regression ? 3 : 0;
+}
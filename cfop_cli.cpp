@@ -0,0 +1,297 @@
+/*  This file is part of "GR Cube"
+
+	Copyright (C) 2020 German Ramos Rodriguez
+
+	This program is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	This program is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+	German Ramos Rodriguez
+	Vigo, Spain
+	grvigo@hotmail.com
+*/
+
+// Command line CFOP solver (without Qt, for batch jobs and throughput measurements)
+// Usage: cfop_cli [options] [scramble ...]
+// Scrambles are read from the arguments, from a file (--file) or from the standard input (one scramble per line)
+
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <cstdlib>
+
+#include "cfop.h"
+
+using namespace grcube3;
+
+namespace
+{
+	// Command line options
+	struct CliOptions
+	{
+		std::vector<std::string> Scrambles; // Scrambles from the arguments
+		std::string ScramblesFile; // File with scrambles (one per line)
+		std::vector<PiecesGroups> Crosses; // Allowed layers for the cross
+		uint CrossDepth = 0u; // Maximum cross search depth (0: default for the cross search)
+		uint XCrossPairs = 0u; // F2L pairs to solve with the cross (0: cross search, 1: XCross, 2: XXCross)
+		std::string XCrossTable; // File for the XCross pruning table (empty: default file)
+		int Threads = 0; // 0: all cores, -1: no threads, other: number of threads
+		bool Use1LLL = false; // 1LLL instead of OLL + PLL
+		bool F2LCases = false; // F2L cases table instead of F2L search
+		bool F2LFallback = false; // F2L search step when no F2L case is recognized
+		bool Json = false; // A JSON object per scramble instead of the text report
+		double Timeout = 0.0; // Time limit for each scramble in seconds (0: no limit)
+	};
+
+	// Print the command line usage
+	void PrintUsage(std::ostream& Out)
+	{
+		Out << "Usage: cfop_cli [options] [scramble ...]\n"
+			   "Scrambles are read from the arguments, from a file or from the standard input (one scramble per line,\n"
+			   "blank lines and lines starting with '#' are skipped).\n"
+			   "Options:\n"
+			   "  -f, --file <path>      Read the scrambles from the given file\n"
+			   "  -c, --cross <layers>   Allowed layers for the cross, as a letters list (default: UDFBRL)\n"
+			   "  -d, --depth <n>        Maximum cross search depth in movements (default: 6, 10 for XCross, 14 for XXCross)\n"
+			   "      --xcross           Search the shortest cross with a solved F2L pair (XCross) instead of the best cross\n"
+			   "      --xxcross          Search the shortest cross with two solved F2L pairs (XXCross) instead of the best cross\n"
+			   "      --xcross-table <path>  File for the XCross pruning table, built the first time (default: xcross_table.dat)\n"
+			   "  -t, --threads <n>      Threads for the searches: 0 = all cores, -1 = no threads (default: 0)\n"
+			   "      --2lll             Solve the last layer with OLL + PLL (default)\n"
+			   "      --1lll             Solve the last layer with 1LLL\n"
+			   "      --f2l-search       Solve the F2L with the pairs search (default)\n"
+			   "      --f2l-cases        Solve the F2L with the F2L cases table (much faster, longer solves)\n"
+			   "      --f2l-fallback     As --f2l-cases, with a pairs search when no pair case is recognized\n"
+			   "  -T, --timeout <s>      Time limit for each scramble in seconds, the best partial solve is returned (default: no limit)\n"
+			   "  -j, --json             Print a JSON object per scramble (one per line) instead of the report\n"
+			   "  -h, --help             Show this help\n";
+	}
+
+	// Read the cross layers from a letters list
+	bool ParseCrossLayers(const std::string& Text, std::vector<PiecesGroups>& Crosses)
+	{
+		Crosses.clear();
+		for (const char C : Text)
+		{
+			PiecesGroups PG;
+			switch (C)
+			{
+			case 'U': case 'u': PG = PiecesGroups::C_U; break;
+			case 'D': case 'd': PG = PiecesGroups::C_D; break;
+			case 'F': case 'f': PG = PiecesGroups::C_F; break;
+			case 'B': case 'b': PG = PiecesGroups::C_B; break;
+			case 'R': case 'r': PG = PiecesGroups::C_R; break;
+			case 'L': case 'l': PG = PiecesGroups::C_L; break;
+			default: return false;
+			}
+			bool Found = false;
+			for (const auto P : Crosses) if (P == PG) Found = true;
+			if (!Found) Crosses.push_back(PG);
+		}
+		return !Crosses.empty();
+	}
+
+	// Read an integer option value
+	bool ParseInt(const std::string& Text, int& Value)
+	{
+		char* End = nullptr;
+		const long V = std::strtol(Text.c_str(), &End, 10);
+		if (Text.empty() || *End != '\0') return false;
+		Value = static_cast<int>(V);
+		return true;
+	}
+
+	// Read the command line options, returns false with an error message if the options are not valid
+	bool ParseOptions(const int argc, char* argv[], CliOptions& Options, std::string& Error)
+	{
+		ParseCrossLayers("UDFBRL", Options.Crosses);
+
+		for (int n = 1; n < argc; n++)
+		{
+			const std::string Arg = argv[n];
+			const bool HasValue = n + 1 < argc;
+
+			if (Arg == "-f" || Arg == "--file")
+			{
+				if (!HasValue) { Error = "Missing file path"; return false; }
+				Options.ScramblesFile = argv[++n];
+			}
+			else if (Arg == "-c" || Arg == "--cross")
+			{
+				if (!HasValue || !ParseCrossLayers(argv[++n], Options.Crosses)) { Error = "Invalid cross layers"; return false; }
+			}
+			else if (Arg == "-d" || Arg == "--depth")
+			{
+				int Depth;
+				if (!HasValue || !ParseInt(argv[++n], Depth) || Depth < 1 || Depth > static_cast<int>(SearchPath::MAX_STEPS)) { Error = "Invalid cross depth"; return false; }
+				Options.CrossDepth = static_cast<uint>(Depth);
+			}
+			else if (Arg == "-t" || Arg == "--threads")
+			{
+				if (!HasValue || !ParseInt(argv[++n], Options.Threads) || Options.Threads < -1) { Error = "Invalid threads number"; return false; }
+			}
+			else if (Arg == "-T" || Arg == "--timeout")
+			{
+				char* End = nullptr;
+				if (HasValue) Options.Timeout = std::strtod(argv[++n], &End);
+				if (!HasValue || *End != '\0' || Options.Timeout < 0.0) { Error = "Invalid timeout"; return false; }
+			}
+			else if (Arg == "--xcross") Options.XCrossPairs = 1u;
+			else if (Arg == "--xxcross") Options.XCrossPairs = 2u;
+			else if (Arg == "--xcross-table")
+			{
+				if (!HasValue) { Error = "Invalid XCross table file"; return false; }
+				Options.XCrossTable = argv[++n];
+			}
+			else if (Arg == "--2lll") Options.Use1LLL = false;
+			else if (Arg == "--1lll") Options.Use1LLL = true;
+			else if (Arg == "--f2l-search") Options.F2LCases = Options.F2LFallback = false;
+			else if (Arg == "--f2l-cases") { Options.F2LCases = true; Options.F2LFallback = false; }
+			else if (Arg == "--f2l-fallback") Options.F2LCases = Options.F2LFallback = true;
+			else if (Arg == "-j" || Arg == "--json") Options.Json = true;
+			else if (Arg == "-h" || Arg == "--help") { Error.clear(); return false; }
+			else if (Arg.size() > 1 && Arg[0] == '-' && Arg[1] == '-') { Error = "Unknown option: " + Arg; return false; }
+			else Options.Scrambles.push_back(Arg); // A scramble (steps as "R'" or "U2" are not options)
+		}
+		return true;
+	}
+
+	// Text as a JSON string
+	std::string JsonString(const std::string& Text)
+	{
+		std::string J = "\"";
+		for (const char C : Text)
+		{
+			if (C == '"' || C == '\\') J += '\\';
+			if (static_cast<unsigned char>(C) >= 0x20u) J += C;
+		}
+		return J + "\"";
+	}
+
+	// Last layer text with the previous turn in parentheses (as in the report)
+	std::string TurnAndSolve(const std::string& Turn, const std::string& Solve)
+	{
+		return Turn.empty() ? Solve : "(" + Turn + ") " + Solve;
+	}
+
+	// Read a scramble from text (false if the text has chars that are not movements or the parentheses don't match)
+	bool ParseScramble(const std::string& Text, Algorithm& Scramble)
+	{
+		for (const char C : Text) if (C != ' ' && C != '\t' && !Algorithm::IsAlgorithmChar(C)) return false;
+		std::string Aux = Text;
+		Scramble.Clear();
+		return Scramble.Append(Aux);
+	}
+
+	// Search the CFOP solve for a scramble (the same steps as the application) and print the result
+	// Returns true if the cube is solved
+	bool SolveScramble(const std::string& Text, const CliOptions& Options, std::ostream& Out)
+	{
+		Algorithm Scramble;
+		if (!ParseScramble(Text, Scramble))
+		{
+			std::cerr << "cfop_cli: Invalid scramble: " << Text << "\n";
+			if (Options.Json) Out << "{\"scramble\":" << JsonString(Text) << ",\"solved\":false,\"error\":\"invalid scramble\"}\n";
+			return false;
+		}
+		Scramble = Scramble.GetSimplified();
+		Scramble = Scramble.GetWithoutTurns();
+		while (Scramble.Shrink());
+
+		CFOP SearchCFOP(Scramble, Options.Threads);
+		SearchCFOP.SetTimeLimit(Options.Timeout);
+
+		const uint Depths[3] = { 6u, 10u, 14u }; // Default depths for cross, XCross and XXCross
+		const uint CrossDepth = Options.CrossDepth > 0u ? Options.CrossDepth : Depths[Options.XCrossPairs];
+		bool Solved = (Options.XCrossPairs > 0u ? SearchCFOP.SearchXCross(CrossDepth, Options.Crosses, Options.XCrossPairs == 2u) :
+												  SearchCFOP.SearchCross(CrossDepth, Options.Crosses)) &&
+					  (Options.F2LCases ? SearchCFOP.SearchF2LCases(Options.F2LFallback) : SearchCFOP.SearchF2L());
+		if (Solved) Solved = Options.Use1LLL ? SearchCFOP.Search1LLL() : SearchCFOP.SearchOLL() && SearchCFOP.SearchPLL();
+		Solved = Solved && (Options.Use1LLL ? SearchCFOP.Is1LLLSolved() : SearchCFOP.IsSolved());
+
+		if (!Options.Json)
+		{
+			Out << SearchCFOP.GetReport() << "\n";
+			return Solved;
+		}
+
+		const double LLTime = Options.Use1LLL ? SearchCFOP.Get1LLLTime() : SearchCFOP.GetOLLTime() + SearchCFOP.GetPLLTime();
+		Out << "{\"scramble\":" << JsonString(SearchCFOP.GetTextScramble())
+			<< ",\"solved\":" << (Solved ? "true" : "false")
+			<< ",\"interrupted\":" << (SearchCFOP.IsInterrupted() ? "true" : "false");
+		if (SearchCFOP.IsCrossSolved())
+		{
+			Out << ",\"cross_layer\":" << JsonString(std::string(1u, Cube::GetLayerChar(SearchCFOP.GetCrossLayer())))
+				<< ",\"inspection\":" << JsonString(SearchCFOP.GetTextInspection())
+				<< ",\"cross\":" << JsonString(SearchCFOP.GetTextCrossSolve())
+				<< ",\"f2l\":[" << JsonString(SearchCFOP.GetTextF2LFirstSolve()) << "," << JsonString(SearchCFOP.GetTextF2LSecondSolve()) << ","
+				<< JsonString(SearchCFOP.GetTextF2LThirdSolve()) << "," << JsonString(SearchCFOP.GetTextF2LFourthSolve()) << "]";
+			if (Options.Use1LLL)
+				Out << ",\"1lll_case\":" << JsonString(SearchCFOP.GetText1LLLCase())
+					<< ",\"1lll\":" << JsonString(TurnAndSolve(SearchCFOP.GetText1LLLTurn(), SearchCFOP.GetText1LLLSolve()));
+			else
+				Out << ",\"oll_case\":" << JsonString(SearchCFOP.GetTextOLLCase())
+					<< ",\"oll\":" << JsonString(TurnAndSolve(SearchCFOP.GetTextOLLTurn(), SearchCFOP.GetTextOLLSolve()))
+					<< ",\"pll_case\":" << JsonString(SearchCFOP.GetTextPLLCase())
+					<< ",\"pll\":" << JsonString(TurnAndSolve(SearchCFOP.GetTextPLLTurn(), SearchCFOP.GetTextPLLSolve()));
+			Out << ",\"auf\":" << JsonString(SearchCFOP.GetTextAUFSolve());
+			if (Solved) Out << ",\"length\":" << SearchCFOP.GetLengthSolve();
+		}
+		Out << ",\"time\":{\"cross\":" << SearchCFOP.GetCrossTime() << ",\"f2l\":" << SearchCFOP.GetF2LTime()
+			<< ",\"ll\":" << LLTime << ",\"total\":" << SearchCFOP.GetFullTime() << "}"
+			<< ",\"threads\":" << SearchCFOP.GetUsedCores() << "}" << std::endl;
+
+		return Solved;
+	}
+}
+
+// Exit code: 0 if all scrambles are solved, 1 for invalid options, 2 if any scramble is not solved
+int main(int argc, char* argv[])
+{
+	CliOptions Options;
+	std::string Error;
+	if (!ParseOptions(argc, argv, Options, Error))
+	{
+		if (!Error.empty()) std::cerr << "cfop_cli: " << Error << "\n";
+		PrintUsage(Error.empty() ? std::cout : std::cerr);
+		return Error.empty() ? 0 : 1;
+	}
+
+	std::vector<std::string> Scrambles = Options.Scrambles;
+	if (!Options.ScramblesFile.empty() || Scrambles.empty())
+	{
+		std::ifstream File;
+		if (!Options.ScramblesFile.empty())
+		{
+			File.open(Options.ScramblesFile);
+			if (!File) { std::cerr << "cfop_cli: Can't open file " << Options.ScramblesFile << "\n"; return 1; }
+		}
+		std::istream& In = Options.ScramblesFile.empty() ? std::cin : File;
+		std::string Line;
+		while (std::getline(In, Line))
+		{
+			if (!Line.empty() && Line.back() == '\r') Line.pop_back();
+			const size_t First = Line.find_first_not_of(" \t");
+			if (First == std::string::npos || Line[First] == '#') continue; // Blank lines and comments
+			Scrambles.push_back(Line);
+		}
+	}
+
+	if (!Options.XCrossTable.empty()) XCrossPruningTable::SetFile(Options.XCrossTable);
+
+	bool AllSolved = true;
+	for (const auto& S : Scrambles) if (!SolveScramble(S, Options, std::cout)) AllSolved = false;
+
+	return AllSolved ? 0 : 2;
+}
@@ -0,0 +1,638 @@
+/*  This file is part of "GR Cube"
+
+	Copyright (C) 2020 German Ramos Rodriguez
+
+	This program is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	This program is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+	German Ramos Rodriguez
+	Vigo, Spain
+	grvigo@hotmail.com
+*/
+
+// CFOP consistency tests (without Qt): checks the internal tables against the direct searches they replace, and the
+// move kernels, transforms, cubes batch and symmetries against the step by step cube movements
+// The XCross test loads the XCross pruning table file from the current directory (or builds and saves it, about a minute)
+// Usage: cfop_tests
+// Exit code: 0 if all tests pass, 1 if any test fails
+
+#include <iostream>
+#include <string>
+#include <set>
+#include <random>
+#include <functional>
+#include <algorithm>
+
+#include "cfop.h"
+#include "cube_batch.h"
+
+namespace grcube3
+{
+	struct CFOPTests
+	{
+		// Check the OLL recognition table against the sequential OLL masks scan and turns check, for all OLL cases,
+		// AUF steps and cross layers (the cube is built as in the solve, with the inspection turn spin)
+		static bool OLLTable()
+		{
+			const Layers CrossLayers[6] = { Layers::U, Layers::D, Layers::F, Layers::B, Layers::R, Layers::L };
+			const Steps Inspections[6] = { Steps::z2, Steps::NONE, Steps::xp, Steps::x, Steps::z, Steps::zp };
+			const Steps AUFSteps[4] = { Steps::NONE, Steps::U, Steps::U2, Steps::Up };
+			const Steps Turns[4] = { Steps::NONE, Steps::y, Steps::y2, Steps::yp };
+
+			uint Errors = 0u;
+			for (uint l = 0u; l < 6u; l++)
+			{
+				for (uint OLL_Index = 0u; OLL_Index < 58u; OLL_Index++)
+				{
+					Algorithm Inverse = CFOP::OLL_Algorithms[OLL_Index][0];
+					Inverse.TransformReverseInvert();
+
+					for (const auto AUF : AUFSteps)
+					{
+						Cube CubeLL;
+						CubeLL.ApplyStep(Inspections[l]);
+						const Spins InspectionSpin = CubeLL.GetSpin();
+						CubeLL.ApplyAlgorithm(Inverse);
+						CubeLL.SetSpin(InspectionSpin);
+						CubeLL.ApplyStep(AUF);
+
+						// Sequential scan (first case with the mask in any orientation)
+						const M16 MaskOLL = CFOP::GetOLLMask(CubeLL, CrossLayers[l]);
+						uint Case;
+						for (Case = 0u; Case < 58u; Case++)
+							if (CFOP::OLL_Masks[0][Case] == MaskOLL || CFOP::OLL_Masks[1][Case] == MaskOLL ||
+								CFOP::OLL_Masks[2][Case] == MaskOLL || CFOP::OLL_Masks[3][Case] == MaskOLL) break;
+
+						// First turn that orients the last layer with the case algorithm
+						Steps Turn = Steps::NONE;
+						bool TurnFound = false;
+						for (uint t = 0u; t < 4u && !TurnFound && Case < 58u; t++)
+						{
+							Cube CubeCheck = CubeLL;
+							CubeCheck.ApplyStep(Turns[t]);
+							Algorithm Solve = CFOP::OLL_Algorithms[Case][0];
+							CubeCheck.ApplyAlgorithm(Solve);
+							if (CubeCheck.IsLayerOriented(Cube::OppositeLayer(CrossLayers[l]))) { Turn = Turns[t]; TurnFound = true; }
+						}
+
+						const CFOP::OLLEntry& Entry = CFOP::GetOLLTable()[MaskOLL];
+						if (Case == 58u || !TurnFound || !Entry.Valid || Entry.Case != Case || Entry.Turn != Turn)
+						{
+							std::cout << "OLL table: layer " << Cube::GetLayerChar(CrossLayers[l]) << ", case " << CFOP::GetTextOLLCase(static_cast<OLL>(OLL_Index))
+									  << ", AUF " << Algorithm::GetTextStep(AUF) << ": table case " << Entry.Case << " (turn " << Algorithm::GetTextStep(Entry.Turn)
+									  << "), scan case " << Case << " (turn " << Algorithm::GetTextStep(Turn) << ")\n";
+							Errors++;
+						}
+					}
+				}
+			}
+			return Errors == 0u;
+		}
+
+		// Check the transposition table: the solves with the table are a deterministic subset of the solves without it, with
+		// the same shortest solve for each cross, and some subtrees are skipped. With threads the table is not used
+		static bool TranspositionTable()
+		{
+			const char* Scrambles[3] = { "R U F' L2 D B R' U2 F D' L B2 U R2 F' D L' B U' R D2 F L U'",
+										 "B' R' F L' U B' L B D B2 D2 B R' D' U' B' D2 F B' U L U B2 R2 F2",
+										 "F U2 L2 B2 F' U L2 U R2 D2 L' B L2 B' R2 U2" };
+			const std::vector<PiecesGroups> Crosses = { PiecesGroups::C_U, PiecesGroups::C_D, PiecesGroups::C_F };
+
+			uint Errors = 0u;
+			for (const auto Text : Scrambles)
+			{
+				Algorithm Scramble(Text);
+				std::vector<SearchLevel> Levels(7);
+				const Cube CubeScramble(Scramble);
+				const auto IsSolving = [&CubeScramble](Algorithm S, const PiecesGroups C) { Cube CubeSolve = CubeScramble; CubeSolve.ApplyAlgorithm(S); return CubeSolve.IsSolved(C); };
+
+				DeepSearch DS(Scramble, Crosses, Levels, true, true), DSTable(Scramble, Crosses, Levels, true, true),
+						   DSRepeat(Scramble, Crosses, Levels, true, true), DSThreads(Scramble, Crosses, Levels, true, true);
+				DS.SetCrossPruning();
+				DSTable.SetCrossPruning();
+				DSRepeat.SetCrossPruning();
+				DSThreads.SetCrossPruning();
+				if (!DSTable.SetTranspositionTable(16u) || !DSRepeat.SetTranspositionTable(16u) || !DSThreads.SetTranspositionTable(16u))
+				{
+					std::cout << "Transposition table: not enabled\n";
+					return false;
+				}
+				DS.Run(-1);
+				DSTable.Run(-1);
+				DSRepeat.Run(-1);
+				DSThreads.Run(0);
+				const std::vector<Algorithm>& TableSolves = DSRepeat.Solves;
+
+				std::set<std::string> AllSolves;
+				for (const auto& S : DS.Solves) AllSolves.insert(S.ToString());
+
+				bool Same = TableSolves.size() == DSTable.Solves.size(), Subset = true, Shortest = true;
+				for (uint n = 0u; Same && n < TableSolves.size(); n++) Same = TableSolves[n].ToString() == DSTable.Solves[n].ToString();
+				bool Threads = DSThreads.GetTableHits() == 0ull && DSThreads.Solves.size() == DS.Solves.size();
+				for (uint n = 0u; Threads && n < DS.Solves.size(); n++) Threads = DS.Solves[n].ToString() == DSThreads.Solves[n].ToString();
+				for (const auto& S : DSTable.Solves) if (AllSolves.count(S.ToString()) == 0u) Subset = false;
+				for (const auto C : Crosses)
+				{
+					uint Best = 0xFFu, BestTable = 0xFFu;
+					for (const auto& S : DS.Solves) if (IsSolving(S, C) && S.GetSize() < Best) Best = S.GetSize();
+					for (const auto& S : DSTable.Solves) if (IsSolving(S, C) && S.GetSize() < BestTable) BestTable = S.GetSize();
+					if (Best != BestTable) Shortest = false;
+				}
+
+				if (!Same || !Subset || !Shortest || !Threads || DSTable.GetTableHits() == 0ull || DSTable.GetNodes() >= DS.GetNodes())
+				{
+					std::cout << "Transposition table: scramble " << Text << ": " << DS.Solves.size() << " solves (" << DS.GetNodes() << " nodes), "
+							  << DSTable.Solves.size() << " solves with the table (" << DSTable.GetNodes() << " nodes, " << DSTable.GetTableHits()
+							  << " hits)" << (Same ? "" : ", not deterministic") << (Subset ? "" : ", not a subset") << (Shortest ? "" : ", longer solves")
+							  << (Threads ? "" : ", table used with threads") << "\n";
+					Errors++;
+				}
+			}
+			return Errors == 0u;
+		}
+
+		// Random single layer steps algorithm (no consecutive steps in the same layer), with cube turns if requested
+		static Algorithm GetRandomAlgorithm(std::mt19937& Random, const uint Length, const bool Turns = false)
+		{
+			Algorithm A;
+			uint PrevFace = 6u;
+			while (A.GetSize() < Length)
+			{
+				if (Turns && Random() % 4u == 0u) { A.Append(static_cast<Steps>(static_cast<uint>(Steps::x) + Random() % 9u)); continue; }
+				const uint Face = Random() % 6u;
+				if (Face == PrevFace) continue;
+				A.Append(static_cast<Steps>(static_cast<uint>(Steps::U) + Face * 3u + Random() % 3u));
+				PrevFace = Face;
+			}
+			return A;
+		}
+
+		// Minimum number of single layer steps (up to the given maximum) to get the given condition, by brute force
+		// Returns the maximum plus one if the condition can't be reached
+		static uint GetMinSteps(const Cube& C, const std::function<bool(const Cube&)>& Condition, const uint Max)
+		{
+			std::function<bool(const Cube&, uint, uint)> Search = [&](const Cube& CubeSearch, const uint Depth, const uint PrevFace)
+			{
+				if (Depth == 0u) return Condition(CubeSearch);
+				for (uint s = 0u; s < 18u; s++)
+				{
+					if (s / 3u == PrevFace) continue;
+					Cube CubeNext = CubeSearch;
+					CubeNext.ApplyStep(static_cast<Steps>(static_cast<uint>(Steps::U) + s));
+					if (Search(CubeNext, Depth - 1u, s / 3u)) return true;
+				}
+				return false;
+			};
+			for (uint Depth = 0u; Depth <= Max; Depth++) if (Search(C, Depth, 6u)) return Depth;
+			return Max + 1u;
+		}
+
+		// Cube with the reference movement functions (the functions replaced by the table-driven move kernels)
+		struct ReferenceCube : public Cube
+		{
+			void Move(const Steps S)
+			{
+				switch (S)
+				{
+				case Steps::U: e_U(); c_U(); break;
+				case Steps::Up: e_Up(); c_Up(); break;
+				case Steps::U2: e_U2(); c_U2(); break;
+				case Steps::D: e_D(); c_D(); break;
+				case Steps::Dp: e_Dp(); c_Dp(); break;
+				case Steps::D2: e_D2(); c_D2(); break;
+				case Steps::F: e_F(); c_F(); break;
+				case Steps::Fp: e_Fp(); c_Fp(); break;
+				case Steps::F2: e_F2(); c_F2(); break;
+				case Steps::B: e_B(); c_B(); break;
+				case Steps::Bp: e_Bp(); c_Bp(); break;
+				case Steps::B2: e_B2(); c_B2(); break;
+				case Steps::R: e_R(); c_R(); break;
+				case Steps::Rp: e_Rp(); c_Rp(); break;
+				case Steps::R2: e_R2(); c_R2(); break;
+				case Steps::L: e_L(); c_L(); break;
+				case Steps::Lp: e_Lp(); c_Lp(); break;
+				case Steps::L2: e_L2(); c_L2(); break;
+				default: break;
+				}
+			}
+		};
+
+		// Check the move kernels and the spin x step dispatch table against the reference movement functions, for random
+		// algorithms with cube turns (the reference keeps the layer in each face position: U, D, F, B, R, L)
+		static bool MoveKernels()
+		{
+			// Face positions cycle for each turn (x, y, z): each position gets the layer from the next one
+			const uint TurnCycles[3][4] = { { 0u, 2u, 1u, 3u }, { 2u, 4u, 3u, 5u }, { 0u, 5u, 1u, 4u } };
+
+			std::mt19937 Random(1u);
+			uint Errors = 0u;
+			for (uint n = 0u; n < 2000u; n++)
+			{
+				Algorithm A = GetRandomAlgorithm(Random, 1u + n % 40u, n % 2u == 1u);
+
+				Cube CubeKernel;
+				CubeKernel.ApplyAlgorithm(A);
+
+				ReferenceCube CubeReference;
+				uint Layers[6] = { 0u, 1u, 2u, 3u, 4u, 5u }; // Layer in each face position
+				for (uint s = 0u; s < A.GetSize(); s++)
+				{
+					const uint Step = static_cast<uint>(A.At(s));
+					if (Step >= static_cast<uint>(Steps::x))
+					{
+						const uint* Cycle = TurnCycles[(Step - static_cast<uint>(Steps::x)) / 3u];
+						const uint Times = (Step - static_cast<uint>(Steps::x)) % 3u == 0u ? 1u : (Step - static_cast<uint>(Steps::x)) % 3u == 1u ? 3u : 2u;
+						for (uint t = 0u; t < Times; t++)
+						{
+							const uint Aux = Layers[Cycle[0]];
+							Layers[Cycle[0]] = Layers[Cycle[1]];
+							Layers[Cycle[1]] = Layers[Cycle[2]];
+							Layers[Cycle[2]] = Layers[Cycle[3]];
+							Layers[Cycle[3]] = Aux;
+						}
+					}
+					else
+					{
+						const uint Face = (Step - static_cast<uint>(Steps::U)) / 3u, Variant = (Step - static_cast<uint>(Steps::U)) % 3u;
+						CubeReference.Move(static_cast<Steps>(static_cast<uint>(Steps::U) + Layers[Face] * 3u + Variant));
+					}
+				}
+
+				if (CubeKernel.GetEdgesStatus() != CubeReference.GetEdgesStatus() || CubeKernel.GetCornersStatus() != CubeReference.GetCornersStatus())
+				{
+					if (Errors < 10u) std::cout << "Move kernels: " << A.ToString() << "\n";
+					Errors++;
+				}
+			}
+			return Errors == 0u;
+		}
+
+		// Check the precompiled algorithms against the algorithms applied step by step, for random algorithms with cube turns,
+		// random start states and all start spins
+		static bool Transforms()
+		{
+			std::mt19937 Random(2u);
+			uint Errors = 0u;
+			for (uint n = 0u; n < 200u; n++)
+			{
+				Algorithm Start = GetRandomAlgorithm(Random, 20u), A = GetRandomAlgorithm(Random, 1u + n % 30u, true);
+				for (uint Sp = 0u; Sp < 24u; Sp++)
+				{
+					Cube CubeSteps(Start);
+					CubeSteps.SetSpin(static_cast<Spins>(Sp));
+					Cube CubeTransform = CubeSteps;
+					CubeSteps.ApplyAlgorithm(A);
+					CubeTransform.ApplyTransform(Cube::GetTransform(A, static_cast<Spins>(Sp)));
+
+					if (CubeSteps.GetEdgesStatus() != CubeTransform.GetEdgesStatus() || CubeSteps.GetCornersStatus() != CubeTransform.GetCornersStatus() ||
+						CubeSteps.GetSpin() != CubeTransform.GetSpin())
+					{
+						if (Errors < 10u) std::cout << "Transforms: " << A.ToString() << ", spin " << Sp << "\n";
+						Errors++;
+					}
+				}
+			}
+			return Errors == 0u;
+		}
+
+		// Check the cubes batch (and the AVX2 kernels if avaliable) against single cubes: a common step, a step for each cube and
+		// solved checks, with a number of cubes that is not a multiple of four
+		static bool Batch()
+		{
+			std::mt19937 Random(3u);
+			const uint Size = 37u;
+
+			std::vector<Pieces> PiecesList;
+			std::vector<Edges> EdgesList;
+			std::vector<Corners> CornersList;
+			Cube::AddToPiecesList(std::vector<PiecesGroups>{ PiecesGroups::C_D, PiecesGroups::F2L_D_DFR }, PiecesList);
+			for (const auto P : PiecesList)
+			{
+				if (Cube::IsEdge(P)) EdgesList.push_back(static_cast<Edges>(static_cast<int>(P) - static_cast<int>(Pieces::First_Edge)));
+				else if (Cube::IsCorner(P)) CornersList.push_back(static_cast<Corners>(static_cast<int>(P) - static_cast<int>(Pieces::First_Corner)));
+			}
+			const S64 EMask = Cube::GetMasksSolvedEdges(EdgesList), CMask = Cube::GetMasksSolvedCorners(CornersList);
+
+			std::vector<Cube> Cubes;
+			CubeBatch Batch;
+			for (uint n = 0u; n < Size; n++)
+			{
+				Algorithm A = GetRandomAlgorithm(Random, n % 4u); // Some cubes with the pieces solved
+				Cubes.push_back(Cube(A));
+				Batch.Add(Cubes.back());
+			}
+
+			uint Errors = 0u;
+			for (uint r = 0u; r < 200u; r++)
+			{
+				if (r % 2u == 0u)
+				{
+					const Steps S = static_cast<Steps>(static_cast<uint>(Steps::U) + Random() % 18u);
+					Batch.ApplyStep(S);
+					for (auto& C : Cubes) C.ApplyStep(S);
+				}
+				else
+				{
+					std::vector<Steps> StepsList;
+					for (auto& C : Cubes)
+					{
+						StepsList.push_back(static_cast<Steps>(Random() % 19u)); // Steps::NONE included
+						C.ApplyStep(StepsList.back());
+					}
+					Batch.ApplySteps(StepsList);
+				}
+
+				std::vector<bool> Solved;
+				uint NSolved = Batch.IsSolved(EMask, CMask, Solved), NCubesSolved = 0u;
+				for (uint n = 0u; n < Size; n++)
+				{
+					if (Cubes[n].IsSolved(EMask, CMask)) NCubesSolved++;
+					if (Batch.GetEdgesStatus(n) != Cubes[n].GetEdgesStatus() || Batch.GetCornersStatus(n) != Cubes[n].GetCornersStatus() ||
+						Solved[n] != Cubes[n].IsSolved(EMask, CMask)) Errors++;
+				}
+				if (NSolved != NCubesSolved) Errors++;
+			}
+			if (Errors > 0u) std::cout << "Batch: " << Errors << " differences with single cubes\n";
+
+			// Both kernels with the same data (the AVX2 kernel is the scalar one if AVX2 is not avaliable)
+			uint KernelErrors = 0u;
+			const CubeBatch::BatchStep* BatchSteps = CubeBatch::GetBatchSteps();
+			for (uint r = 0u; r < 1000u; r++)
+			{
+				S64 E[4], C[4], EAVX2[4], CAVX2[4];
+				const CubeBatch::BatchStep* Lanes[4];
+				for (uint l = 0u; l < 4u; l++)
+				{
+					Algorithm A = GetRandomAlgorithm(Random, r % 6u);
+					const Cube CubeLane(A);
+					E[l] = EAVX2[l] = CubeLane.GetEdgesStatus();
+					C[l] = CAVX2[l] = CubeLane.GetCornersStatus();
+					Lanes[l] = BatchSteps + CubeBatch::GetBatchStepIndex(static_cast<Steps>(Random() % 19u));
+				}
+				CubeBatch::ApplyLanes(E, C, Lanes);
+				CubeBatch::ApplyLanesAVX2(EAVX2, CAVX2, Lanes);
+				const S64 ESolved = Cube().GetEdgesStatus() & EMask, CSolved = Cube().GetCornersStatus() & CMask;
+				for (uint l = 0u; l < 4u; l++) if (E[l] != EAVX2[l] || C[l] != CAVX2[l]) KernelErrors++;
+				if (CubeBatch::GetSolvedLanes(E, C, EMask, ESolved, CMask, CSolved) != CubeBatch::GetSolvedLanesAVX2(E, C, EMask, ESolved, CMask, CSolved)) KernelErrors++;
+			}
+			if (KernelErrors > 0u) std::cout << "Batch: " << KernelErrors << " differences between the scalar and the AVX2 kernels\n";
+
+			return Errors == 0u && KernelErrors == 0u;
+		}
+
+		// Check the cube symmetries: a step and its symmetric step commute with the symmetry, and all the symmetric cubes have
+		// the same canonical form and hash
+		static bool Symmetries()
+		{
+			std::mt19937 Random(4u);
+			uint Errors = 0u;
+			for (uint n = 0u; n < 50u; n++)
+			{
+				Algorithm A = GetRandomAlgorithm(Random, 25u);
+				const Cube C(A);
+				uint CanonicalSym;
+				const Cube Canonical = C.GetCanonical(CanonicalSym);
+				if (C.GetSymmetric(CanonicalSym).GetEdgesStatus() != Canonical.GetEdgesStatus()) Errors++;
+
+				for (uint Sym = 0u; Sym < Cube::SYMMETRIES; Sym++)
+				{
+					const Cube CubeSym = C.GetSymmetric(Sym);
+					for (uint s = static_cast<uint>(Steps::U); s <= static_cast<uint>(Steps::L2); s++)
+					{
+						Cube CubeStep = C, CubeSymStep = CubeSym;
+						CubeStep.ApplyStep(static_cast<Steps>(s));
+						CubeSymStep.ApplyStep(Cube::GetSymmetricStep(Sym, static_cast<Steps>(s)));
+						const Cube CubeStepSym = CubeStep.GetSymmetric(Sym);
+						if (CubeStepSym.GetEdgesStatus() != CubeSymStep.GetEdgesStatus() || CubeStepSym.GetCornersStatus() != CubeSymStep.GetCornersStatus()) Errors++;
+					}
+
+					uint Aux;
+					const Cube CanonicalSym = CubeSym.GetCanonical(Aux);
+					if (CanonicalSym.GetEdgesStatus() != Canonical.GetEdgesStatus() || CanonicalSym.GetCornersStatus() != Canonical.GetCornersStatus() ||
+						CanonicalSym.GetHash() != Canonical.GetHash()) Errors++;
+				}
+			}
+			if (Errors > 0u) std::cout << "Symmetries: " << Errors << " errors\n";
+			return Errors == 0u;
+		}
+
+		// Check the crosses pruning tables distances against a brute force search (up to five movements)
+		static bool CrossTables()
+		{
+			const PiecesGroups Crosses[6] = { PiecesGroups::C_U, PiecesGroups::C_D, PiecesGroups::C_F, PiecesGroups::C_B, PiecesGroups::C_R, PiecesGroups::C_L };
+			const uint Max = 5u;
+
+			std::mt19937 Random(5u);
+			uint Errors = 0u;
+			for (const auto Cross : Crosses)
+			{
+				std::vector<Pieces> PiecesList;
+				std::vector<Edges> EdgesList;
+				Cube::AddToPiecesList(Cross, PiecesList);
+				for (const auto P : PiecesList) EdgesList.push_back(static_cast<Edges>(static_cast<int>(P) - static_cast<int>(Pieces::First_Edge)));
+				const CrossPruningTable* Table = CrossPruningTable::Get(Cube::GetMasksSolvedEdges(EdgesList));
+
+				for (uint n = 0u; n < 25u; n++)
+				{
+					Algorithm A = GetRandomAlgorithm(Random, n % (Max + 3u));
+					const Cube C(A);
+					const uint Distance = Table->GetDistance(C);
+					const uint Steps = GetMinSteps(C, [Cross](const Cube& CubeCheck) { return CubeCheck.IsSolved(Cross); }, Max);
+					if ((Distance > Max ? Max + 1u : Distance) != Steps)
+					{
+						std::cout << "Cross tables: " << A.ToString() << ": table distance " << Distance << ", " << Steps << " movements\n";
+						Errors++;
+					}
+				}
+			}
+			return Errors == 0u;
+		}
+
+		// Check the XCross pruning table distances against a brute force search (up to five movements)
+		// The table is loaded from (or built and saved to) the default table file
+		static bool XCrossTable()
+		{
+			const XCrossPruningTable* Table = XCrossPruningTable::Get();
+			const uint Max = 5u;
+
+			std::mt19937 Random(6u);
+			uint Errors = 0u;
+			for (uint n = 0u; n < 40u; n++)
+			{
+				Algorithm A = GetRandomAlgorithm(Random, n % (Max + 3u));
+				const Cube C(A);
+				const uint Distance = Table->GetDistance(C);
+				const uint Steps = GetMinSteps(C, [](const Cube& CubeCheck) { return CubeCheck.IsSolved(PiecesGroups::C_D) && CubeCheck.IsSolved(PiecesGroups::F2L_D_DFR); }, Max);
+				if ((Distance > Max ? Max + 1u : Distance) != Steps)
+				{
+					std::cout << "XCross table: " << A.ToString() << ": table distance " << Distance << ", " << Steps << " movements\n";
+					Errors++;
+				}
+			}
+			return Errors == 0u;
+		}
+
+		// Check the 1LLL index against the sequential algorithms, turns and AUF scan, for all cross layers (the cube is built
+		// as in the solve, with the inspection turn spin)
+		static bool Index1LLL()
+		{
+			const Steps Inspections[6] = { Steps::z2, Steps::NONE, Steps::xp, Steps::x, Steps::z, Steps::zp };
+			const Steps AUFSteps[4] = { Steps::NONE, Steps::U, Steps::U2, Steps::Up };
+
+			std::mt19937 Random(7u);
+			uint Errors = 0u;
+			for (uint l = 0u; l < 6u; l++)
+			{
+				for (uint n = 0u; n < 10u; n++)
+				{
+					const uint Case = Random() % static_cast<uint>(CFOP::Algorithms_1LLL.size());
+					Algorithm Inverse = CFOP::Algorithms_1LLL[Case].GetDeveloped(false);
+					Inverse.TransformReverseInvert();
+
+					Cube CubeLL;
+					CubeLL.ApplyStep(Inspections[l]);
+					const Spins InspectionSpin = CubeLL.GetSpin();
+					CubeLL.ApplyAlgorithm(Inverse);
+					CubeLL.SetSpin(InspectionSpin);
+					CubeLL.ApplyStep(AUFSteps[Random() % 4u]);
+
+					// Sequential scan (first algorithm, turn and AUF that solves the cube)
+					uint Order = 0xFFFFFFFFu;
+					for (uint a = 0u; a < CFOP::Algorithms_1LLL.size() && Order == 0xFFFFFFFFu; a++)
+						for (uint t = 0u; t < 4u && Order == 0xFFFFFFFFu; t++)
+						{
+							Cube CubeCheck = CubeLL;
+							CubeCheck.ApplyStep(CFOP::Turns_1LLL[t]);
+							Algorithm Solve = CFOP::Algorithms_1LLL[a];
+							CubeCheck.ApplyAlgorithm(Solve);
+							for (uint u = 0u; u < 4u && Order == 0xFFFFFFFFu; u++)
+							{
+								Cube CubeAUF = CubeCheck;
+								CubeAUF.ApplyStep(CFOP::AUFs_1LLL[u]);
+								if (CubeAUF.IsSolved()) Order = (a << 4) | (t << 2) | u;
+							}
+						}
+
+					const std::vector<CFOP::Entry1LLL>& Index = CFOP::Get1LLLIndex(InspectionSpin);
+					const CFOP::Entry1LLL Key = { CubeLL.GetEdgesStatus(), CubeLL.GetCornersStatus(), 0u };
+					auto Entry = std::lower_bound(Index.begin(), Index.end(), Key);
+					const bool Found = Entry != Index.end() && Entry->Edges == Key.Edges && Entry->Corners == Key.Corners;
+					if (!Found || Entry->Order != Order)
+					{
+						std::cout << "1LLL index: layer " << Cube::GetLayerChar(static_cast<Layers>(static_cast<uint>(Layers::U) + l)) << ", case " << Case + 1u
+								  << ": index order " << (Found ? static_cast<int>(Entry->Order) : -1) << ", scan order " << static_cast<int>(Order) << "\n";
+						Errors++;
+					}
+				}
+			}
+			return Errors == 0u;
+		}
+
+		// Check the F2L cases table: each case position is solved by the table solve, not longer than the case algorithm, and
+		// the F2L cases solver completes the F2L from random cubes with the cross solved, for all cross layers
+		static bool F2LCases()
+		{
+			const Steps AUFSteps[4] = { Steps::NONE, Steps::U, Steps::U2, Steps::Up };
+
+			uint Errors = 0u;
+			for (uint Case = 0u; Case < 41u; Case++)
+			{
+				Algorithm Inverse = CFOP::F2L_Algorithms[Case][0].GetDeveloped(false);
+				Inverse.TransformReverseInvert();
+				for (const auto AUF : AUFSteps)
+				{
+					Cube CubeCase(Inverse);
+					CubeCase.ApplyStep(Algorithm::GetInvertedStep(AUF));
+
+					const CFOP::F2LEntry& Entry = CFOP::GetF2LTable()[CFOP::GetF2LIndex(CubeCase)];
+					Cube CubeSolve = CubeCase;
+					CubeSolve.ApplyStep(Entry.AUF);
+					Algorithm Solve = CFOP::F2L_Algorithms[Entry.Case][0];
+					CubeSolve.ApplyAlgorithm(Solve);
+					const uint Length = CFOP::F2L_Algorithms[Case][0].GetNumSteps() + (AUF == Steps::NONE ? 0u : 1u);
+					if (!Entry.Valid || !CubeSolve.IsSolved(PiecesGroups::C_D) || !CubeSolve.IsSolved(PiecesGroups::F2L_D_DFR) || Entry.Length > Length)
+					{
+						std::cout << "F2L cases: case " << Case << ", AUF " << Algorithm::GetTextStep(AUF) << ": table case " << Entry.Case << "\n";
+						Errors++;
+					}
+				}
+			}
+
+			// Random cubes with the cross solved (the opposite layer steps and the side layer quarter turns conjugated with the opposite layer)
+			// and two final side layer steps, as the cross search skips the first level
+			const PiecesGroups Crosses[6] = { PiecesGroups::C_U, PiecesGroups::C_D, PiecesGroups::C_F, PiecesGroups::C_B, PiecesGroups::C_R, PiecesGroups::C_L };
+			std::mt19937 Random(8u);
+			for (uint l = 0u; l < 6u; l++)
+			{
+				const uint Opposite = l ^ 1u;
+				for (uint n = 0u; n < 10u; n++)
+				{
+					Algorithm Scramble;
+					for (uint c = 0u; c < 12u; c++)
+					{
+						const uint Side = Random() % 6u, Variant = Random() % 2u;
+						const Steps OppositeStep = static_cast<Steps>(static_cast<uint>(Steps::U) + Opposite * 3u + Random() % 3u);
+						if (Side == l || Side == Opposite) { Scramble.Append(OppositeStep); continue; }
+						const Steps SideStep = static_cast<Steps>(static_cast<uint>(Steps::U) + Side * 3u + Variant);
+						Scramble.Append(SideStep);
+						Scramble.Append(OppositeStep);
+						Scramble.Append(Algorithm::GetInvertedStep(SideStep));
+					}
+					uint Side1 = Random() % 6u, Side2 = Random() % 6u;
+					while (Side1 == l || Side1 == Opposite) Side1 = Random() % 6u;
+					while (Side2 == l || Side2 == Opposite || Side2 == Side1) Side2 = Random() % 6u;
+					Scramble.Append(static_cast<Steps>(static_cast<uint>(Steps::U) + Side1 * 3u + Random() % 3u));
+					Scramble.Append(static_cast<Steps>(static_cast<uint>(Steps::U) + Side2 * 3u + Random() % 3u));
+
+					CFOP SearchCFOP(Scramble, -1);
+					if (!SearchCFOP.SearchCross(4u, { Crosses[l] }) || !SearchCFOP.SearchF2LCases() || !SearchCFOP.IsF2LSolved())
+					{
+						std::cout << "F2L cases: cross " << Cube::GetLayerChar(static_cast<Layers>(static_cast<uint>(Layers::U) + l)) << ", scramble "
+								  << Scramble.ToString() << " not solved\n";
+						Errors++;
+					}
+				}
+			}
+			return Errors == 0u;
+		}
+	};
+}
+
+using namespace grcube3;
+
+int main()
+{
+	const struct { const char* Name; bool (*Run)(); } Tests[] =
+	{
+		{ "OLL table", CFOPTests::OLLTable },
+		{ "Transposition table", CFOPTests::TranspositionTable },
+		{ "Move kernels", CFOPTests::MoveKernels },
+		{ "Transforms", CFOPTests::Transforms },
+		{ "Cubes batch", CFOPTests::Batch },
+		{ "Symmetries", CFOPTests::Symmetries },
+		{ "Cross pruning tables", CFOPTests::CrossTables },
+		{ "1LLL index", CFOPTests::Index1LLL },
+		{ "F2L cases table", CFOPTests::F2LCases },
+		{ "XCross pruning table", CFOPTests::XCrossTable },
+	};
+
+	bool AllPassed = true;
+	for (const auto& T : Tests)
+	{
+		const bool Passed = T.Run();
+		std::cout << (Passed ? "PASS " : "FAIL ") << T.Name << "\n";
+		if (!Passed) AllPassed = false;
+	}
+
+	return AllPassed ? 0 : 1;
+}
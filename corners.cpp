@@ -180,6 +180,86 @@ namespace grcube3
 		{Stickers::DBR_B, Stickers::DBR_R, Stickers::DBR_D}  // DBR
 	};
 
+	// Array to get the source positions of the corners moved by each single layer step
+	const CornerPositions c_Corners::c_MovSrc[18][4] =
+	{
+		{ CornerPositions::UBR, CornerPositions::UFR, CornerPositions::UFL, CornerPositions::UBL }, // U
+		{ CornerPositions::UFL, CornerPositions::UBL, CornerPositions::UBR, CornerPositions::UFR }, // U'
+		{ CornerPositions::UBL, CornerPositions::UBR, CornerPositions::UFR, CornerPositions::UFL }, // U2
+		{ CornerPositions::DFL, CornerPositions::DBL, CornerPositions::DBR, CornerPositions::DFR }, // D
+		{ CornerPositions::DBR, CornerPositions::DFR, CornerPositions::DFL, CornerPositions::DBL }, // D'
+		{ CornerPositions::DBL, CornerPositions::DBR, CornerPositions::DFR, CornerPositions::DFL }, // D2
+		{ CornerPositions::UFL, CornerPositions::DFL, CornerPositions::UFR, CornerPositions::DFR }, // F
+		{ CornerPositions::DFR, CornerPositions::UFR, CornerPositions::DFL, CornerPositions::UFL }, // F'
+		{ CornerPositions::DFL, CornerPositions::DFR, CornerPositions::UFL, CornerPositions::UFR }, // F2
+		{ CornerPositions::UBR, CornerPositions::DBR, CornerPositions::UBL, CornerPositions::DBL }, // B
+		{ CornerPositions::DBL, CornerPositions::UBL, CornerPositions::DBR, CornerPositions::UBR }, // B'
+		{ CornerPositions::DBR, CornerPositions::DBL, CornerPositions::UBR, CornerPositions::UBL }, // B2
+		{ CornerPositions::DFR, CornerPositions::UFR, CornerPositions::DBR, CornerPositions::UBR }, // R
+		{ CornerPositions::UBR, CornerPositions::DBR, CornerPositions::UFR, CornerPositions::DFR }, // R'
+		{ CornerPositions::DBR, CornerPositions::DFR, CornerPositions::UBR, CornerPositions::UFR }, // R2
+		{ CornerPositions::UBL, CornerPositions::DBL, CornerPositions::UFL, CornerPositions::DFL }, // L
+		{ CornerPositions::DFL, CornerPositions::UFL, CornerPositions::DBL, CornerPositions::UBL }, // L'
+		{ CornerPositions::DBL, CornerPositions::DFL, CornerPositions::UBL, CornerPositions::UFL }  // L2
+	};
+
+	// Array to get the destination positions of the corners moved by each single layer step
+	const CornerPositions c_Corners::c_MovDst[18][4] =
+	{
+		{ CornerPositions::UFR, CornerPositions::UFL, CornerPositions::UBL, CornerPositions::UBR }, // U
+		{ CornerPositions::UFR, CornerPositions::UFL, CornerPositions::UBL, CornerPositions::UBR }, // U'
+		{ CornerPositions::UFR, CornerPositions::UFL, CornerPositions::UBL, CornerPositions::UBR }, // U2
+		{ CornerPositions::DFR, CornerPositions::DFL, CornerPositions::DBL, CornerPositions::DBR }, // D
+		{ CornerPositions::DFR, CornerPositions::DFL, CornerPositions::DBL, CornerPositions::DBR }, // D'
+		{ CornerPositions::DFR, CornerPositions::DFL, CornerPositions::DBL, CornerPositions::DBR }, // D2
+		{ CornerPositions::UFR, CornerPositions::UFL, CornerPositions::DFR, CornerPositions::DFL }, // F
+		{ CornerPositions::UFR, CornerPositions::UFL, CornerPositions::DFR, CornerPositions::DFL }, // F'
+		{ CornerPositions::UFR, CornerPositions::UFL, CornerPositions::DFR, CornerPositions::DFL }, // F2
+		{ CornerPositions::UBL, CornerPositions::UBR, CornerPositions::DBL, CornerPositions::DBR }, // B
+		{ CornerPositions::UBL, CornerPositions::UBR, CornerPositions::DBL, CornerPositions::DBR }, // B'
+		{ CornerPositions::UBL, CornerPositions::UBR, CornerPositions::DBL, CornerPositions::DBR }, // B2
+		{ CornerPositions::UFR, CornerPositions::UBR, CornerPositions::DFR, CornerPositions::DBR }, // R
+		{ CornerPositions::UFR, CornerPositions::UBR, CornerPositions::DFR, CornerPositions::DBR }, // R'
+		{ CornerPositions::UFR, CornerPositions::UBR, CornerPositions::DFR, CornerPositions::DBR }, // R2
+		{ CornerPositions::UFL, CornerPositions::UBL, CornerPositions::DFL, CornerPositions::DBL }, // L
+		{ CornerPositions::UFL, CornerPositions::UBL, CornerPositions::DFL, CornerPositions::DBL }, // L'
+		{ CornerPositions::UFL, CornerPositions::UBL, CornerPositions::DFL, CornerPositions::DBL }  // L2
+	};
+
+	// Array to get the mask of the corners not affected by each single layer step
+	const S64 c_Corners::c_MovKeep[18] =
+	{
+		CMASK_DATA & ~CMASK_U, CMASK_DATA & ~CMASK_U, CMASK_DATA & ~CMASK_U, // U, U', U2
+		CMASK_DATA & ~CMASK_D, CMASK_DATA & ~CMASK_D, CMASK_DATA & ~CMASK_D, // D, D', D2
+		CMASK_DATA & ~CMASK_F, CMASK_DATA & ~CMASK_F, CMASK_DATA & ~CMASK_F, // F, F', F2
+		CMASK_DATA & ~CMASK_B, CMASK_DATA & ~CMASK_B, CMASK_DATA & ~CMASK_B, // B, B', B2
+		CMASK_DATA & ~CMASK_R, CMASK_DATA & ~CMASK_R, CMASK_DATA & ~CMASK_R, // R, R', R2
+		CMASK_DATA & ~CMASK_L, CMASK_DATA & ~CMASK_L, CMASK_DATA & ~CMASK_L // L, L', L2
+	};
+
+	// Array to get the new direction of the corners moved by each single layer step (quarter turns swap the two directions normal to the axis)
+	const S64 c_Corners::c_MovDir[18][4] =
+	{ //      UD             FB             RL
+		{ CORNER_DIR_UD, CORNER_DIR_RL, CORNER_DIR_FB, CORNER_DIR_UD }, // U
+		{ CORNER_DIR_UD, CORNER_DIR_RL, CORNER_DIR_FB, CORNER_DIR_UD }, // U'
+		{ CORNER_DIR_UD, CORNER_DIR_FB, CORNER_DIR_RL, CORNER_DIR_UD }, // U2
+		{ CORNER_DIR_UD, CORNER_DIR_RL, CORNER_DIR_FB, CORNER_DIR_UD }, // D
+		{ CORNER_DIR_UD, CORNER_DIR_RL, CORNER_DIR_FB, CORNER_DIR_UD }, // D'
+		{ CORNER_DIR_UD, CORNER_DIR_FB, CORNER_DIR_RL, CORNER_DIR_UD }, // D2
+		{ CORNER_DIR_RL, CORNER_DIR_FB, CORNER_DIR_UD, CORNER_DIR_UD }, // F
+		{ CORNER_DIR_RL, CORNER_DIR_FB, CORNER_DIR_UD, CORNER_DIR_UD }, // F'
+		{ CORNER_DIR_UD, CORNER_DIR_FB, CORNER_DIR_RL, CORNER_DIR_UD }, // F2
+		{ CORNER_DIR_RL, CORNER_DIR_FB, CORNER_DIR_UD, CORNER_DIR_UD }, // B
+		{ CORNER_DIR_RL, CORNER_DIR_FB, CORNER_DIR_UD, CORNER_DIR_UD }, // B'
+		{ CORNER_DIR_UD, CORNER_DIR_FB, CORNER_DIR_RL, CORNER_DIR_UD }, // B2
+		{ CORNER_DIR_FB, CORNER_DIR_UD, CORNER_DIR_RL, CORNER_DIR_UD }, // R
+		{ CORNER_DIR_FB, CORNER_DIR_UD, CORNER_DIR_RL, CORNER_DIR_UD }, // R'
+		{ CORNER_DIR_UD, CORNER_DIR_FB, CORNER_DIR_RL, CORNER_DIR_UD }, // R2
+		{ CORNER_DIR_FB, CORNER_DIR_UD, CORNER_DIR_RL, CORNER_DIR_UD }, // L
+		{ CORNER_DIR_FB, CORNER_DIR_UD, CORNER_DIR_RL, CORNER_DIR_UD }, // L'
+		{ CORNER_DIR_UD, CORNER_DIR_FB, CORNER_DIR_RL, CORNER_DIR_UD }  // L2
+	};
+
 	void c_Corners::c_U() // U
 	{
 		S64 buffer = GetStatus_UFR();
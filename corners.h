@@ -30,6 +30,7 @@ namespace grcube3
 {
 	class c_Corners
 	{
+		friend class CubeBatch; // Uses the movements tables
 	public:
 		c_Corners() { corners = CMASK_SOLVED; }
 		~c_Corners() {}
@@ -233,6 +234,11 @@ namespace grcube3
 		static constexpr auto s_DBL_B = s_UFL_F; // Array to get the sticker in the DBL_B sticker position
 		static constexpr auto s_DBL_L = s_UFL_L; // Array to get the sticker in the DBL_L sticker position
 		
+		static const CornerPositions c_MovSrc[18][4]; // Array to get the source positions of the corners moved by each single layer step
+		static const CornerPositions c_MovDst[18][4]; // Array to get the destination positions of the corners moved by each single layer step
+		static const S64 c_MovKeep[18]; // Array to get the mask of the corners not affected by each single layer step
+		static const S64 c_MovDir[18][4]; // Array to get the new direction of the corners moved by each single layer step
+
 		void c_Reset() { corners = CMASK_SOLVED; } // Reset corners status
 	
 		// Movements
@@ -242,6 +248,20 @@ namespace grcube3
 		void c_B();		void c_B2();	void c_Bp();
 		void c_R();		void c_R2();	void c_Rp();
 		void c_L();		void c_L2();	void c_Lp();
+
+		// Table-driven movement for single layer steps (from Steps::U to Steps::L2)
+		// Same result as the movement functions above (kept as reference), but without branches
+		void c_Move(const Steps S)
+		{
+			const uint m = static_cast<uint>(S) - static_cast<uint>(Steps::U);
+			S64 c = corners & c_MovKeep[m];
+			for (uint n = 0u; n < 4u; n++)
+			{
+				const S64 status = (corners >> (static_cast<uint>(c_MovSrc[m][n]) << 3)) & 0x37ull; // Position + direction
+				c |= ((status & 0x07ull) | (c_MovDir[m][status >> 4] << 4)) << (static_cast<uint>(c_MovDst[m][n]) << 3);
+			}
+			corners = c;
+		}
 	
 		// Get corners status bits (position + direction)
 		S64 GetStatus_UFR() const { return (corners & CMASK_UFR); }
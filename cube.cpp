@@ -131,582 +131,135 @@ namespace grcube3
 		"LU", "LF", "LD", "LB"
 	};
 
-	void Cube::U() // Movement U
-	{
-		switch (spin)
-	    {
-	        case Spins::UF:
-	        case Spins::UR:
-	        case Spins::UB:
-			case Spins::UL: e_U(); c_U(); break;
-	        case Spins::DF:
-	        case Spins::DR:
-	        case Spins::DB:
-	        case Spins::DL: e_D(); c_D(); break;
-	        case Spins::FU:
-	        case Spins::FR:
-	        case Spins::FD:
-			case Spins::FL: e_F(); c_F(); break;
-	        case Spins::BU:
-	        case Spins::BR:
-	        case Spins::BD:
-			case Spins::BL: e_B(); c_B(); break;
-	        case Spins::RU:
-	        case Spins::RF:
-	        case Spins::RD:
-			case Spins::RB: e_R(); c_R(); break;
-	        // case Spins::LU:
-	        // case Spins::LF:
-	        // case Spins::LD:
-	        // case Spins::LB:
-			default: e_L(); c_L(); break;
-	    }
-	}
-	
-	void Cube::U2()  // Movement U2
-	{
-		switch (spin)
-	    {
-	        case Spins::UF:
-	        case Spins::UR:
-	        case Spins::UB:
-	        case Spins::UL: e_U2(); c_U2(); break;
-	        case Spins::DF:
-	        case Spins::DR:
-	        case Spins::DB:
-	        case Spins::DL: e_D2(); c_D2(); break;
-	        case Spins::FU:
-	        case Spins::FR:
-	        case Spins::FD:
-	        case Spins::FL: e_F2(); c_F2(); break;
-	        case Spins::BU:
-	        case Spins::BR:
-	        case Spins::BD:
-	        case Spins::BL: e_B2(); c_B2(); break;
-	        case Spins::RU:
-	        case Spins::RF:
-	        case Spins::RD:
-	        case Spins::RB: e_R2(); c_R2(); break;
-	        // case Spins::LU:
-	        // case Spins::LF:
-	        // case Spins::LD:
-	        // case Spins::LB:
-			default: e_L2(); c_L2(); break;                 
-	    }
-	}
-	
-	void Cube::Up()  // Movement U'
-	{
-		switch (spin)
-	    {
-	        case Spins::UF:
-	        case Spins::UR:
-	        case Spins::UB:
-	        case Spins::UL: e_Up(); c_Up(); break;
-	        case Spins::DF:
-	        case Spins::DR:
-	        case Spins::DB:
-	        case Spins::DL: e_Dp(); c_Dp(); break;
-	        case Spins::FU:
-	        case Spins::FR:
-	        case Spins::FD:
-	        case Spins::FL: e_Fp(); c_Fp(); break;
-	        case Spins::BU:
-	        case Spins::BR:
-	        case Spins::BD:
-	        case Spins::BL: e_Bp(); c_Bp(); break;
-	        case Spins::RU:
-	        case Spins::RF:
-	        case Spins::RD:
-	        case Spins::RB: e_Rp(); c_Rp(); break;
-	        // case Spins::LU:
-	        // case Spins::LF:
-	        // case Spins::LD:
-	        // case Spins::LB:
-			default: e_Lp(); c_Lp(); break;                 
-	    }
-	}
-	
-	void Cube::D()  // Movement D
-	{
-	    switch (spin)
-	    {
-	    	case Spins::UF:
-	    	case Spins::UR:
-	    	case Spins::UB:
-	    	case Spins::UL: e_D(); c_D(); break;
-	    	case Spins::DF:
-	    	case Spins::DR:
-	    	case Spins::DB:
-	    	case Spins::DL: e_U(); c_U(); break;
-	    	case Spins::FU:
-	    	case Spins::FR:
-	    	case Spins::FD:
-	    	case Spins::FL: e_B(); c_B(); break;
-	    	case Spins::BU:
-	    	case Spins::BR:
-	    	case Spins::BD:
-	    	case Spins::BL: e_F(); c_F(); break;
-	    	case Spins::RU:
-	    	case Spins::RF:
-	    	case Spins::RD:
-	    	case Spins::RB: e_L(); c_L(); break;
-	    	// case Spins::LU:
-	    	// case Spins::LF:
-	    	// case Spins::LD:
-	    	// case Spins::LB:
-	    	default: e_R(); c_R(); break;
-	    }
-	}
-	
-	void Cube::D2()  // Movement D2
-	{
-	    switch (spin)
-	    {
-	    	case Spins::UF:
-	    	case Spins::UR:
-	    	case Spins::UB:
-	    	case Spins::UL: e_D2(); c_D2(); break;
-	    	case Spins::DF:
-	    	case Spins::DR:
-	    	case Spins::DB:
-	    	case Spins::DL: e_U2(); c_U2(); break;
-	    	case Spins::FU:
-	    	case Spins::FR:
-	    	case Spins::FD:
-	    	case Spins::FL: e_B2(); c_B2(); break;
-	    	case Spins::BU:
-	    	case Spins::BR:
-	    	case Spins::BD:
-	    	case Spins::BL: e_F2(); c_F2(); break;
-	    	case Spins::RU:
-	    	case Spins::RF:
-	    	case Spins::RD:
-	    	case Spins::RB: e_L2(); c_L2(); break;
-	    	// case Spins::LU:
-	    	// case Spins::LF:
-	    	// case Spins::LD:
-	    	// case Spins::LB:
-	    	default: e_R2(); c_R2(); break;
-	    }
-	}
-	
-	void Cube::Dp()  // Movement D'
-	{
-	    switch (spin)
-	    {
-	    	case Spins::UF:
-	    	case Spins::UR:
-	    	case Spins::UB:
-	    	case Spins::UL: e_Dp(); c_Dp(); break;
-	    	case Spins::DF:
-	    	case Spins::DR:
-	    	case Spins::DB:
-	    	case Spins::DL: e_Up(); c_Up(); break;
-	    	case Spins::FU:
-	    	case Spins::FR:
-	    	case Spins::FD:
-	    	case Spins::FL: e_Bp(); c_Bp(); break;
-	    	case Spins::BU:
-	    	case Spins::BR:
-	    	case Spins::BD:
-	    	case Spins::BL: e_Fp(); c_Fp(); break;
-	    	case Spins::RU:
-	    	case Spins::RF:
-	    	case Spins::RD:
-	    	case Spins::RB: e_Lp(); c_Lp(); break;
-	    	// case Spins::LU:
-	    	// case Spins::LF:
-	    	// case Spins::LD:
-	    	// case Spins::LB:
-	    	default: e_Rp(); c_Rp(); break;
-	    }
-	}
-	
-	void Cube::F()  // Movement F
-	{
-	    switch (spin)
-	    {
-	        case Spins::FU:
-	        case Spins::BU:
-	        case Spins::RU:
-	        case Spins::LU: e_U(); c_U(); break;
-	        case Spins::FD:
-	        case Spins::BD:
-	        case Spins::RD:
-	        case Spins::LD: e_D(); c_D(); break;
-	        case Spins::UF:
-	        case Spins::DF:
-	        case Spins::RF:
-	        case Spins::LF: e_F(); c_F(); break;
-	        case Spins::UB:
-	        case Spins::DB:
-	        case Spins::RB:
-	        case Spins::LB: e_B(); c_B(); break;
-	        case Spins::UR:
-	        case Spins::DR:
-	        case Spins::FR:
-	        case Spins::BR: e_R(); c_R(); break;
-	        // case Spins::UL:
-	        // case Spins::DL:
-	        // case Spins::FL:
-	        // case Spins::BL:
-	        default: e_L(); c_L(); break;
-		}
-	}
-	
-	void Cube::F2()  // Movement F2
-	{
-	    switch (spin)
-	    {
-	        case Spins::FU:
-	        case Spins::BU:
-	        case Spins::RU:
-	        case Spins::LU: e_U2(); c_U2(); break;
-	        case Spins::FD:
-	        case Spins::BD:
-	        case Spins::RD:
-	        case Spins::LD: e_D2(); c_D2(); break;
-	        case Spins::UF:
-	        case Spins::DF:
-	        case Spins::RF:
-	        case Spins::LF: e_F2(); c_F2(); break;
-	        case Spins::UB:
-	        case Spins::DB:
-	        case Spins::RB:
-	        case Spins::LB: e_B2(); c_B2(); break;
-	        case Spins::UR:
-	        case Spins::DR:
-	        case Spins::FR:
-	        case Spins::BR: e_R2(); c_R2(); break;
-	        // case Spins::UL:
-	        // case Spins::DL:
-	        // case Spins::FL:
-	        // case Spins::BL:
-	        default: e_L2(); c_L2(); break;
-		}
-	}
-	
-	void Cube::Fp()  // Movement F'
-	{
-	    switch (spin)
-	    {
-	        case Spins::FU:
-	        case Spins::BU:
-	        case Spins::RU:
-	        case Spins::LU: e_Up(); c_Up(); break;
-	        case Spins::FD:
-	        case Spins::BD:
-	        case Spins::RD:
-	        case Spins::LD: e_Dp(); c_Dp(); break;
-	        case Spins::UF:
-	        case Spins::DF:
-	        case Spins::RF:
-	        case Spins::LF: e_Fp(); c_Fp(); break;
-	        case Spins::UB:
-	        case Spins::DB:
-	        case Spins::RB:
-	        case Spins::LB: e_Bp(); c_Bp(); break;
-	        case Spins::UR:
-	        case Spins::DR:
-	        case Spins::FR:
-	        case Spins::BR: e_Rp(); c_Rp(); break;
-	        // case Spins::UL:
-	        // case Spins::DL:
-	        // case Spins::FL:
-	        // case Spins::BL:
-	        default: e_Lp(); c_Lp(); break;
-		}
-	}
-	
-	void Cube::B()  // Movement B
-	{
-		switch (spin)
-	    {
-	        case Spins::FU:
-	        case Spins::BU:
-	        case Spins::RU:
-	        case Spins::LU: e_D(); c_D(); break;
-	        case Spins::FD:
-	        case Spins::BD:
-	        case Spins::RD:
-	        case Spins::LD: e_U(); c_U(); break;
-	        case Spins::UF:
-	        case Spins::DF:
-	        case Spins::RF:
-	        case Spins::LF: e_B(); c_B(); break;
-	        case Spins::UB:
-	        case Spins::DB:
-	        case Spins::RB:
-	        case Spins::LB: e_F(); c_F(); break;
-	        case Spins::UR:
-	        case Spins::DR:
-	        case Spins::FR:
-	        case Spins::BR: e_L(); c_L(); break;
-	        // case Spins::UL:
-	        // case Spins::DL:
-	        // case Spins::FL:
-	        // case Spins::BL:
-			default: e_R(); c_R(); break;
-		}
-	}
-	
-	void Cube::B2()  // Movement B2
-	{
-		switch (spin)
-	    {
-	        case Spins::FU:
-	        case Spins::BU:
-	        case Spins::RU:
-	        case Spins::LU: e_D2(); c_D2(); break;
-	        case Spins::FD:
-	        case Spins::BD:
-	        case Spins::RD:
-	        case Spins::LD: e_U2(); c_U2(); break;
-	        case Spins::UF:
-	        case Spins::DF:
-	        case Spins::RF:
-	        case Spins::LF: e_B2(); c_B2(); break;
-	        case Spins::UB:
-	        case Spins::DB:
-	        case Spins::RB:
-	        case Spins::LB: e_F2(); c_F2(); break;
-	        case Spins::UR:
-	        case Spins::DR:
-	        case Spins::FR:
-	        case Spins::BR: e_L2(); c_L2(); break;
-	        // case Spins::UL:
-	        // case Spins::DL:
-	        // case Spins::FL:
-	        // case Spins::BL:
-			default: e_R2(); c_R2(); break;
-		}
-	}
-	
-	void Cube::Bp()  // Movement B'
+	// Array to get the physical face turned by each face movement (U, D, F, B, R, L) for each spin
+	const Faces Cube::f_SpinFaces[24][6] =
+	{ //      U         D         F         B         R         L
+		{ Faces::U, Faces::D, Faces::F, Faces::B, Faces::R, Faces::L }, // UF
+		{ Faces::U, Faces::D, Faces::R, Faces::L, Faces::B, Faces::F }, // UR
+		{ Faces::U, Faces::D, Faces::B, Faces::F, Faces::L, Faces::R }, // UB
+		{ Faces::U, Faces::D, Faces::L, Faces::R, Faces::F, Faces::B }, // UL
+		{ Faces::D, Faces::U, Faces::F, Faces::B, Faces::L, Faces::R }, // DF
+		{ Faces::D, Faces::U, Faces::R, Faces::L, Faces::F, Faces::B }, // DR
+		{ Faces::D, Faces::U, Faces::B, Faces::F, Faces::R, Faces::L }, // DB
+		{ Faces::D, Faces::U, Faces::L, Faces::R, Faces::B, Faces::F }, // DL
+		{ Faces::F, Faces::B, Faces::U, Faces::D, Faces::L, Faces::R }, // FU
+		{ Faces::F, Faces::B, Faces::R, Faces::L, Faces::U, Faces::D }, // FR
+		{ Faces::F, Faces::B, Faces::D, Faces::U, Faces::R, Faces::L }, // FD
+		{ Faces::F, Faces::B, Faces::L, Faces::R, Faces::D, Faces::U }, // FL
+		{ Faces::B, Faces::F, Faces::U, Faces::D, Faces::R, Faces::L }, // BU
+		{ Faces::B, Faces::F, Faces::R, Faces::L, Faces::D, Faces::U }, // BR
+		{ Faces::B, Faces::F, Faces::D, Faces::U, Faces::L, Faces::R }, // BD
+		{ Faces::B, Faces::F, Faces::L, Faces::R, Faces::U, Faces::D }, // BL
+		{ Faces::R, Faces::L, Faces::U, Faces::D, Faces::F, Faces::B }, // RU
+		{ Faces::R, Faces::L, Faces::F, Faces::B, Faces::D, Faces::U }, // RF
+		{ Faces::R, Faces::L, Faces::D, Faces::U, Faces::B, Faces::F }, // RD
+		{ Faces::R, Faces::L, Faces::B, Faces::F, Faces::U, Faces::D }, // RB
+		{ Faces::L, Faces::R, Faces::U, Faces::D, Faces::B, Faces::F }, // LU
+		{ Faces::L, Faces::R, Faces::F, Faces::B, Faces::U, Faces::D }, // LF
+		{ Faces::L, Faces::R, Faces::D, Faces::U, Faces::F, Faces::B }, // LD
+		{ Faces::L, Faces::R, Faces::B, Faces::F, Faces::D, Faces::U }  // LB
+	};
+
+	// Array with the face movements (as seen in spin UF) and the turn applied by each step, from Steps::NONE to Steps::z2
+	const Steps Cube::s_StepsSequence[DISPATCH_STEPS][3] =
+	{ //  Movement 1   Movement 2   Turn
+		{ Steps::NONE, Steps::NONE, Steps::NONE }, // NONE
+
+		{ Steps::U, Steps::NONE, Steps::NONE }, // U
+		{ Steps::Up, Steps::NONE, Steps::NONE }, // Up
+		{ Steps::U2, Steps::NONE, Steps::NONE }, // U2
+		{ Steps::D, Steps::NONE, Steps::NONE }, // D
+		{ Steps::Dp, Steps::NONE, Steps::NONE }, // Dp
+		{ Steps::D2, Steps::NONE, Steps::NONE }, // D2
+		{ Steps::F, Steps::NONE, Steps::NONE }, // F
+		{ Steps::Fp, Steps::NONE, Steps::NONE }, // Fp
+		{ Steps::F2, Steps::NONE, Steps::NONE }, // F2
+		{ Steps::B, Steps::NONE, Steps::NONE }, // B
+		{ Steps::Bp, Steps::NONE, Steps::NONE }, // Bp
+		{ Steps::B2, Steps::NONE, Steps::NONE }, // B2
+		{ Steps::R, Steps::NONE, Steps::NONE }, // R
+		{ Steps::Rp, Steps::NONE, Steps::NONE }, // Rp
+		{ Steps::R2, Steps::NONE, Steps::NONE }, // R2
+		{ Steps::L, Steps::NONE, Steps::NONE }, // L
+		{ Steps::Lp, Steps::NONE, Steps::NONE }, // Lp
+		{ Steps::L2, Steps::NONE, Steps::NONE }, // L2
+
+		{ Steps::D, Steps::NONE, Steps::y }, // u
+		{ Steps::Dp, Steps::NONE, Steps::yp }, // up
+		{ Steps::D2, Steps::NONE, Steps::y2 }, // u2
+		{ Steps::U, Steps::NONE, Steps::yp }, // d
+		{ Steps::Up, Steps::NONE, Steps::y }, // dp
+		{ Steps::U2, Steps::NONE, Steps::y2 }, // d2
+		{ Steps::B, Steps::NONE, Steps::z }, // f
+		{ Steps::Bp, Steps::NONE, Steps::zp }, // fp
+		{ Steps::B2, Steps::NONE, Steps::z2 }, // f2
+		{ Steps::F, Steps::NONE, Steps::zp }, // b
+		{ Steps::Fp, Steps::NONE, Steps::z }, // bp
+		{ Steps::F2, Steps::NONE, Steps::z2 }, // b2
+		{ Steps::L, Steps::NONE, Steps::x }, // r
+		{ Steps::Lp, Steps::NONE, Steps::xp }, // rp
+		{ Steps::L2, Steps::NONE, Steps::x2 }, // r2
+		{ Steps::R, Steps::NONE, Steps::xp }, // l
+		{ Steps::Rp, Steps::NONE, Steps::x }, // lp
+		{ Steps::R2, Steps::NONE, Steps::x2 }, // l2
+
+		{ Steps::U, Steps::Dp, Steps::yp }, // E
+		{ Steps::Up, Steps::D, Steps::y }, // Ep
+		{ Steps::U2, Steps::D2, Steps::y2 }, // E2
+		{ Steps::Fp, Steps::B, Steps::z }, // S
+		{ Steps::F, Steps::Bp, Steps::zp }, // Sp
+		{ Steps::F2, Steps::B2, Steps::z2 }, // S2
+		{ Steps::R, Steps::Lp, Steps::xp }, // M
+		{ Steps::Rp, Steps::L, Steps::x }, // Mp
+		{ Steps::R2, Steps::L2, Steps::x2 }, // M2
+
+		{ Steps::NONE, Steps::NONE, Steps::x }, // x
+		{ Steps::NONE, Steps::NONE, Steps::xp }, // xp
+		{ Steps::NONE, Steps::NONE, Steps::x2 }, // x2
+		{ Steps::NONE, Steps::NONE, Steps::y }, // y
+		{ Steps::NONE, Steps::NONE, Steps::yp }, // yp
+		{ Steps::NONE, Steps::NONE, Steps::y2 }, // y2
+		{ Steps::NONE, Steps::NONE, Steps::z }, // z
+		{ Steps::NONE, Steps::NONE, Steps::zp }, // zp
+		{ Steps::NONE, Steps::NONE, Steps::z2 }  // z2
+	};
+
+	// Dispatch table with the physical movements and the final spin for each step in each spin
+	Cube::StepDispatch Cube::s_Dispatch[24][DISPATCH_STEPS];
+
+	// The dispatch table is filled once at startup
+	const bool Cube::s_DispatchReady = Cube::InitDispatch();
+
+	// Fill the dispatch table from the spin faces and steps sequence arrays
+	bool Cube::InitDispatch()
 	{
-		switch (spin)
-	    {
-	        case Spins::FU:
-	        case Spins::BU:
-	        case Spins::RU:
-	        case Spins::LU: e_Dp(); c_Dp(); break;
-	        case Spins::FD:
-	        case Spins::BD:
-	        case Spins::RD:
-	        case Spins::LD: e_Up(); c_Up(); break;
-	        case Spins::UF:
-	        case Spins::DF:
-	        case Spins::RF:
-	        case Spins::LF: e_Bp(); c_Bp(); break;
-	        case Spins::UB:
-	        case Spins::DB:
-	        case Spins::RB:
-	        case Spins::LB: e_Fp(); c_Fp(); break;
-	        case Spins::UR:
-	        case Spins::DR:
-	        case Spins::FR:
-	        case Spins::BR: e_Lp(); c_Lp(); break;
-	        // case Spins::UL:
-	        // case Spins::DL:
-	        // case Spins::FL:
-	        // case Spins::BL:
-			default: e_Rp(); c_Rp(); break;
+		for (uint sp = 0u; sp < 24u; sp++)
+		{
+			for (uint st = 0u; st < DISPATCH_STEPS; st++)
+			{
+				StepDispatch& SD = s_Dispatch[sp][st];
+				SD.Move1 = GetPhysicalStep(static_cast<Spins>(sp), s_StepsSequence[st][0]);
+				SD.Move2 = GetPhysicalStep(static_cast<Spins>(sp), s_StepsSequence[st][1]);
+
+				const Steps Turn = s_StepsSequence[st][2];
+				SD.Spin = Turn == Steps::NONE ? static_cast<Spins>(sp) :
+				          s_Spins[sp][static_cast<uint>(Turn) - static_cast<uint>(Steps::x)];
+			}
 		}
+		return true;
 	}
-	
-	void Cube::R()  // Movement R
-	{
-	    switch (spin)
-	    {
-	        case Spins::FR:
-	        case Spins::BL:
-	        case Spins::RB:
-	        case Spins::LF: e_U(); c_U(); break;
-	        case Spins::FL:
-	        case Spins::BR:
-	        case Spins::RF:
-	        case Spins::LB: e_D(); c_D(); break;
-	        case Spins::UL:
-	        case Spins::DR:
-	        case Spins::RU:
-	        case Spins::LD: e_F(); c_F(); break;
-	        case Spins::UR:
-	        case Spins::DL:
-	        case Spins::RD:
-	        case Spins::LU: e_B(); c_B(); break;
-	        case Spins::UF:
-	        case Spins::DB:
-	        case Spins::FD:
-	        case Spins::BU: e_R(); c_R(); break;
-	        // case Spins::UB:
-	        // case Spins::DF:
-	        // case Spins::FU:
-	        // case Spins::BD:
-	        default: e_L(); c_L(); break;
-	    }
-	}
-	
-	void Cube::R2()  // Movement R2
-	{
-	    switch (spin)
-	    {
-	        case Spins::FR:
-	        case Spins::BL:
-	        case Spins::RB:
-	        case Spins::LF: e_U2(); c_U2(); break;
-	        case Spins::FL:
-	        case Spins::BR:
-	        case Spins::RF:
-	        case Spins::LB: e_D2(); c_D2(); break;
-	        case Spins::UL:
-	        case Spins::DR:
-	        case Spins::RU:
-	        case Spins::LD: e_F2(); c_F2(); break;
-	        case Spins::UR:
-	        case Spins::DL:
-	        case Spins::RD:
-	        case Spins::LU: e_B2(); c_B2(); break;
-	        case Spins::UF:
-	        case Spins::DB:
-	        case Spins::FD:
-	        case Spins::BU: e_R2(); c_R2(); break;
-	        // case Spins::UB:
-	        // case Spins::DF:
-	        // case Spins::FU:
-	        // case Spins::BD:
-	        default: e_L2(); c_L2(); break;
-	    }
-	}
-	
-	void Cube::Rp()  // Movement R'
-	{
-	    switch (spin)
-	    {
-	        case Spins::FR:
-	        case Spins::BL:
-	        case Spins::RB:
-	        case Spins::LF: e_Up(); c_Up(); break;
-	        case Spins::FL:
-	        case Spins::BR:
-	        case Spins::RF:
-	        case Spins::LB: e_Dp(); c_Dp(); break;
-	        case Spins::UL:
-	        case Spins::DR:
-	        case Spins::RU:
-	        case Spins::LD: e_Fp(); c_Fp(); break;
-	        case Spins::UR:
-	        case Spins::DL:
-	        case Spins::RD:
-	        case Spins::LU: e_Bp(); c_Bp(); break;
-	        case Spins::UF:
-	        case Spins::DB:
-	        case Spins::FD:
-	        case Spins::BU: e_Rp(); c_Rp(); break;
-	        // case Spins::UB:
-	        // case Spins::DF:
-	        // case Spins::FU:
-	        // case Spins::BD:
-	        default: e_Lp(); c_Lp(); break;
-	    }
-	}
-	
-	void Cube::L()  // Movement L
-	{
-	    switch (spin)
-	    {
-	        case Spins::FR:
-	        case Spins::BL:
-	        case Spins::RB:
-	        case Spins::LF: e_D(); c_D(); break;
-	        case Spins::FL:
-	        case Spins::BR:
-	        case Spins::RF:
-	        case Spins::LB: e_U(); c_U(); break;
-	        case Spins::UL:
-	        case Spins::DR:
-	        case Spins::RU:
-	    	case Spins::LD: e_B(); c_B(); break;
-	        case Spins::UR:
-	        case Spins::DL:
-	        case Spins::RD:
-	        case Spins::LU: e_F(); c_F(); break;
-	        case Spins::UF:
-	        case Spins::DB:
-	        case Spins::FD:
-	        case Spins::BU: e_L(); c_L(); break;
-	        // case Spins::UB:
-	        // case Spins::DF:
-	        // case Spins::FU:
-	        // case Spins::BD:
-	        default: e_R(); c_R(); break;
-	    }
-	}
-	
-	void Cube::L2()  // Movement L2
-	{
-	    switch (spin)
-	    {
-	        case Spins::FR:
-	        case Spins::BL:
-	        case Spins::RB:
-	        case Spins::LF: e_D2(); c_D2(); break;
-	        case Spins::FL:
-	        case Spins::BR:
-	        case Spins::RF:
-	        case Spins::LB: e_U2(); c_U2(); break;
-	        case Spins::UL:
-	        case Spins::DR:
-	        case Spins::RU:
-	    	case Spins::LD: e_B2(); c_B2(); break;
-	        case Spins::UR:
-	        case Spins::DL:
-	        case Spins::RD:
-	        case Spins::LU: e_F2(); c_F2(); break;
-	        case Spins::UF:
-	        case Spins::DB:
-	        case Spins::FD:
-	        case Spins::BU: e_L2(); c_L2(); break;
-	        // case Spins::UB:
-	        // case Spins::DF:
-	        // case Spins::FU:
-	        // case Spins::BD:
-	        default: e_R2(); c_R2(); break;
-	    }
-	}
-	
-	void Cube::Lp()  // Movement L'
+
+	// Get the physical single layer step for the given single layer step in the given spin
+	Steps Cube::GetPhysicalStep(const Spins sp, const Steps S)
 	{
-	    switch (spin)
-	    {
-	        case Spins::FR:
-	        case Spins::BL:
-	        case Spins::RB:
-	        case Spins::LF: e_Dp(); c_Dp(); break;
-	        case Spins::FL:
-	        case Spins::BR:
-	        case Spins::RF:
-	        case Spins::LB: e_Up(); c_Up(); break;
-	        case Spins::UL:
-	        case Spins::DR:
-	        case Spins::RU:
-	    	case Spins::LD: e_Bp(); c_Bp(); break;
-	        case Spins::UR:
-	        case Spins::DL:
-	        case Spins::RD:
-	        case Spins::LU: e_Fp(); c_Fp(); break;
-	        case Spins::UF:
-	        case Spins::DB:
-	        case Spins::FD:
-	        case Spins::BU: e_Lp(); c_Lp(); break;
-	        // case Spins::UB:
-	        // case Spins::DF:
-	        // case Spins::FU:
-	        // case Spins::BD:
-	        default: e_Rp(); c_Rp(); break;
-	    }
+		if (S < Steps::U || S > Steps::L2) return Steps::NONE;
+
+		const uint Index = static_cast<uint>(S) - static_cast<uint>(Steps::U); // Three steps per face
+		const uint Face = static_cast<uint>(f_SpinFaces[static_cast<uint>(sp)][Index / 3u]);
+
+		return static_cast<Steps>(static_cast<uint>(Steps::U) + 3u * Face + Index % 3u);
 	}
-	
+
 	// Apply algorithm to cube (algorithm should have developed parentheses)
 	// If there are parentheses with more than one repetitions returns false and cube status remains unchanged
 	bool Cube::ApplyAlgorithm(Algorithm& A)
@@ -729,76 +282,262 @@ namespace grcube3
 	    return true;
 	}
 
-	// Apply movement (step) to the cube
+	// Get the precompiled transform of an algorithm, to be applied to cubes with the given spin
+	// The algorithm is applied to solved cubes, so each position gets the source position of his piece
+	CubeTransform Cube::GetTransform(Algorithm& A, const Spins sp)
+	{
+		CubeTransform T;
+		Algorithm Developed = A.GetDeveloped(false);
+
+		for (uint d = 0u; d < 3u; d++) // A cube for each corners direction
+		{
+			Cube C;
+			C.spin = sp;
+			C.corners = CMASK_SOLVED | (static_cast<S64>(d) * 0x1010101010101010ull);
+			C.ApplyAlgorithm(Developed);
+
+			if (d == 0u)
+			{
+				T.StartSpin = sp;
+				T.EndSpin = C.spin;
+				T.EdgesFlip = C.edges & 0x0FFF000000000000ull; // Direction bits
+				for (uint p = 0u; p < 12u; p++) T.EdgesSource[p] = static_cast<uint>((C.edges >> (p << 2)) & 0xFull);
+				for (uint p = 0u; p < 8u; p++) T.CornersSource[p] = static_cast<uint>((C.corners >> (p << 3)) & 0x7ull);
+			}
+			for (uint p = 0u; p < 8u; p++) T.CornersDir[p][d] = (C.corners >> ((p << 3) + 4u)) & 0x3ull;
+		}
+		return T;
+	}
+
+	// Apply a precompiled algorithm (fixed cost whatever the algorithm length)
+	bool Cube::ApplyTransform(const CubeTransform& T)
+	{
+		if (spin != T.StartSpin) return false;
+
+		S64 e = 0ull, c = 0ull;
+		for (uint p = 0u; p < 12u; p++)
+		{
+			const uint src = T.EdgesSource[p];
+			e |= ((edges >> (src << 2)) & 0xFull) << (p << 2); // Position
+			e |= ((edges >> (src + 48u)) & 0x1ull) << (p + 48u); // Direction
+		}
+		for (uint p = 0u; p < 8u; p++)
+		{
+			const S64 status = (corners >> (T.CornersSource[p] << 3)) & 0xFFull;
+			c |= ((status & 0x7ull) | (T.CornersDir[p][status >> 4] << 4)) << (p << 3);
+		}
+		edges = e ^ T.EdgesFlip;
+		corners = c;
+		spin = T.EndSpin;
+		return true;
+	}
+
+	// Apply movement (step) to the cube through the dispatch table (no spin fast path is in the header)
 	// Returns false if the step is a close parentheses with more than one repetition
-	bool Cube::ApplyStep(const Steps s)
+	bool Cube::ApplyStepDispatch(const Steps s)
+	{
+		if (s > Steps::z2) return s == Steps::PARENTHESIS_OPEN || s == Steps::PARENTHESIS_CLOSE_1_REP;
+
+		const StepDispatch& SD = s_Dispatch[static_cast<uint>(spin)][static_cast<uint>(s)];
+		if (SD.Move1 != Steps::NONE) { e_Move(SD.Move1); c_Move(SD.Move1); }
+		if (SD.Move2 != Steps::NONE) { e_Move(SD.Move2); c_Move(SD.Move2); }
+		spin = SD.Spin;
+
+		return true;
+	}
+
+	// Symmetries tables
+	Faces Cube::sy_Faces[48][6];
+	uint Cube::sy_EdgePos[48][12];
+	uint Cube::sy_CornerPos[48][8];
+	bool Cube::sy_Mirror[48];
+	unsigned char Cube::sy_EdgeStatus[48][12][32];
+	unsigned char Cube::sy_CornerStatus[48][8][64];
+
+	// The symmetries tables are filled once at startup
+	const bool Cube::sy_Ready = Cube::InitSymmetries();
+
+	// Fill the symmetries tables
+	// Each symmetry is a permutation of the three axes (x = RL, y = UD, z = FB) with a sign change for each axis (index = permutation * 8 + signs)
+	// The conjugated cube gets in each symmetric sticker position the symmetric of the original sticker
+	bool Cube::InitSymmetries()
 	{
-		switch (s)
+		const uint AxisPerms[6][3] = { { 0u, 1u, 2u }, { 0u, 2u, 1u }, { 1u, 0u, 2u }, { 1u, 2u, 0u }, { 2u, 0u, 1u }, { 2u, 1u, 0u } };
+		const bool OddPerm[6] = { false, true, true, false, false, true };
+		const uint FaceAxis[6] = { 1u, 1u, 2u, 2u, 0u, 0u }; // U, D, F, B, R, L
+		const Faces AxisFaces[3][2] = { { Faces::R, Faces::L }, { Faces::U, Faces::D }, { Faces::F, Faces::B } }; // Positive and negative face for each axis
+		const Faces EdgeFaces[12][2] = // Faces of each edge position (in the same order than the sticker positions)
 		{
-			case Steps::U: 	U(); 	return true;
-			case Steps::Up: Up();	return true;
-			case Steps::U2: U2(); 	return true;
-			case Steps::D: 	D(); 	return true;
-			case Steps::Dp: Dp(); 	return true;
-			case Steps::D2: D2(); 	return true;
-			case Steps::F: 	F(); 	return true;
-			case Steps::Fp: Fp();	return true;
-			case Steps::F2: F2(); 	return true;
-			case Steps::B: 	B(); 	return true;
-			case Steps::Bp: Bp(); 	return true;
-			case Steps::B2: B2(); 	return true;
-			case Steps::R: 	R(); 	return true;
-			case Steps::Rp: Rp(); 	return true;
-			case Steps::R2: R2(); 	return true;
-			case Steps::L: 	L(); 	return true;
-			case Steps::Lp: Lp(); 	return true;
-			case Steps::L2: L2(); 	return true;
-			
-			case Steps::x: 	x(); 	return true;
-			case Steps::xp: xp(); 	return true;
-			case Steps::x2: x2(); 	return true;
-			case Steps::y: 	y(); 	return true;
-			case Steps::yp: yp(); 	return true;
-			case Steps::y2: y2(); 	return true;
-			case Steps::z: 	z(); 	return true;
-			case Steps::zp: zp(); 	return true;
-			case Steps::z2: z2(); 	return true;
-
-			case Steps::u: 	D(); 	y(); 	return true;
-			case Steps::up: Dp();	yp(); 	return true;
-			case Steps::u2: D2(); 	y2();	return true;
-			case Steps::d: 	U();	yp();	return true;
-			case Steps::dp: Up(); 	y();	return true;
-			case Steps::d2: U2();	y2();	return true;
-			case Steps::f: 	B();	z();	return true;
-			case Steps::fp: Bp();	zp();	return true;
-			case Steps::f2: B2();	z2();	return true;
-			case Steps::b: 	F();	zp();	return true;
-			case Steps::bp: Fp();	z();	return true;
-			case Steps::b2: F2();	z2();	return true;
-			case Steps::r: 	L();	x();	return true;
-			case Steps::rp: Lp();	xp();	return true;
-			case Steps::r2: L2();	x2();	return true;
-			case Steps::l: 	R();	xp();	return true;
-			case Steps::lp: Rp();	x();	return true;
-			case Steps::l2: R2();	x2();	return true;
-
-			case Steps::E:	U();	Dp();	yp();	return true; // E -> As layer D
-			case Steps::Ep:	Up();	D();	y();	return true; // E'
-			case Steps::E2:	U2();	D2();	y2();	return true; // E2
-			case Steps::S:	Fp();	B();	z();	return true; // S -> As layer F
-			case Steps::Sp:	F();	Bp();	zp();	return true; // S'
-			case Steps::S2:	F2();	B2();	z2();	return true; // S2
-			case Steps::M:	R();	Lp();	xp();	return true; // M -> As layer L
-			case Steps::Mp:	Rp();	L();	x();	return true; // M'
-			case Steps::M2:	R2();	L2();	x2();	return true; // M2
-
-			case Steps::NONE:
-			case Steps::PARENTHESIS_OPEN:
-			case Steps::PARENTHESIS_CLOSE_1_REP: return true;
-
-			default: return false; // Close parentheses step with more than one repetition
+			{ Faces::F, Faces::R }, { Faces::F, Faces::L }, { Faces::B, Faces::L }, { Faces::B, Faces::R },
+			{ Faces::U, Faces::F }, { Faces::U, Faces::L }, { Faces::U, Faces::B }, { Faces::U, Faces::R },
+			{ Faces::D, Faces::F }, { Faces::D, Faces::L }, { Faces::D, Faces::B }, { Faces::D, Faces::R }
+		};
+		const Faces CornerFaces[8][3] = // Faces of each corner position (in the same order than the sticker positions)
+		{
+			{ Faces::U, Faces::F, Faces::R }, { Faces::U, Faces::F, Faces::L }, { Faces::U, Faces::B, Faces::L }, { Faces::U, Faces::B, Faces::R },
+			{ Faces::D, Faces::F, Faces::R }, { Faces::D, Faces::F, Faces::L }, { Faces::D, Faces::B, Faces::L }, { Faces::D, Faces::B, Faces::R }
+		};
+		const uint FirstEdgeSticker = static_cast<uint>(StickerPositions::First_Edge), FirstCornerSticker = static_cast<uint>(StickerPositions::First_Corner);
+
+		// Edge or corner status in a single position of a solved cube
+		auto EdgeProbe = [](const uint Pos, const uint Status) -> Cube
+		{
+			Cube C;
+			C.edges = (EMASK_SOLVED & ~(0xFull << (Pos << 2))) | (static_cast<S64>(Status & 0xFu) << (Pos << 2)) | (static_cast<S64>(Status >> 4) << (Pos + 48u));
+			return C;
+		};
+		auto CornerProbe = [](const uint Pos, const uint Status) -> Cube
+		{
+			Cube C;
+			C.corners = (CMASK_SOLVED & ~(0xFFull << (Pos << 3))) | (static_cast<S64>(Status) << (Pos << 3));
+			return C;
+		};
+
+		// Edge and corner status in each position for each sticker in the first sticker position
+		unsigned char EdgeFromSticker[12][54], CornerFromSticker[8][54];
+		for (uint p = 0u; p < 12u; p++)
+			for (uint st = 0u; st < 32u; st++)
+				if ((st & 0xFu) < 12u) EdgeFromSticker[p][static_cast<uint>(EdgeProbe(p, st).GetSticker(static_cast<StickerPositions>(FirstEdgeSticker + 2u * p)))] = static_cast<unsigned char>(st);
+		for (uint p = 0u; p < 8u; p++)
+			for (uint st = 0u; st < 64u; st++)
+				if ((st & 0x8u) == 0u && (st >> 4) < 3u) CornerFromSticker[p][static_cast<uint>(CornerProbe(p, st).GetSticker(static_cast<StickerPositions>(FirstCornerSticker + 3u * p)))] = static_cast<unsigned char>(st);
+
+		for (uint s = 0u; s < SYMMETRIES; s++)
+		{
+			const uint* Perm = AxisPerms[s >> 3];
+			bool Mirror = OddPerm[s >> 3];
+			for (uint a = 0u; a < 3u; a++) if ((s >> a) & 1u) Mirror = !Mirror;
+			sy_Mirror[s] = Mirror;
+
+			for (uint f = 0u; f < 6u; f++)
+			{
+				const uint a = FaceAxis[f];
+				const uint Negative = (f & 1u) ^ ((s >> a) & 1u);
+				sy_Faces[s][f] = AxisFaces[Perm[a]][Negative];
+			}
+			auto SymFace = [&](const Faces F) { return sy_Faces[s][static_cast<uint>(F)]; };
+
+			// Symmetric sticker position (centers are not used)
+			uint StickerMap[54];
+			for (uint f = 0u; f < 6u; f++) StickerMap[f] = static_cast<uint>(SymFace(static_cast<Faces>(f)));
+			for (uint p = 0u; p < 12u; p++)
+			{
+				const Faces F0 = SymFace(EdgeFaces[p][0]), F1 = SymFace(EdgeFaces[p][1]);
+				for (uint q = 0u; q < 12u; q++)
+				{
+					if (EdgeFaces[q][0] == F0 && EdgeFaces[q][1] == F1)
+					{
+						StickerMap[FirstEdgeSticker + 2u * p] = FirstEdgeSticker + 2u * q;
+						StickerMap[FirstEdgeSticker + 2u * p + 1u] = FirstEdgeSticker + 2u * q + 1u;
+						sy_EdgePos[s][p] = q;
+					}
+					else if (EdgeFaces[q][0] == F1 && EdgeFaces[q][1] == F0)
+					{
+						StickerMap[FirstEdgeSticker + 2u * p] = FirstEdgeSticker + 2u * q + 1u;
+						StickerMap[FirstEdgeSticker + 2u * p + 1u] = FirstEdgeSticker + 2u * q;
+						sy_EdgePos[s][p] = q;
+					}
+				}
+			}
+			for (uint p = 0u; p < 8u; p++)
+			{
+				const Faces F[3] = { SymFace(CornerFaces[p][0]), SymFace(CornerFaces[p][1]), SymFace(CornerFaces[p][2]) };
+				for (uint q = 0u; q < 8u; q++)
+				{
+					uint Slots[3], Found = 0u;
+					for (uint i = 0u; i < 3u; i++)
+						for (uint j = 0u; j < 3u; j++)
+							if (CornerFaces[q][j] == F[i]) { Slots[i] = j; Found++; }
+					if (Found < 3u) continue;
+					for (uint i = 0u; i < 3u; i++) StickerMap[FirstCornerSticker + 3u * p + i] = FirstCornerSticker + 3u * q + Slots[i];
+					sy_CornerPos[s][p] = q;
+				}
+			}
+
+			// New status for each edge and corner status in each position
+			for (uint p = 0u; p < 12u; p++)
+			{
+				const uint q = sy_EdgePos[s][p];
+				for (uint st = 0u; st < 32u; st++)
+				{
+					sy_EdgeStatus[s][p][st] = 0u;
+					if ((st & 0xFu) >= 12u) continue;
+					const Cube C = EdgeProbe(p, st);
+					for (uint i = 0u; i < 2u; i++)
+					{
+						const uint Pos = FirstEdgeSticker + 2u * p + i;
+						if (StickerMap[Pos] != FirstEdgeSticker + 2u * q) continue;
+						sy_EdgeStatus[s][p][st] = EdgeFromSticker[q][StickerMap[static_cast<uint>(C.GetSticker(static_cast<StickerPositions>(Pos)))]];
+					}
+				}
+			}
+			for (uint p = 0u; p < 8u; p++)
+			{
+				const uint q = sy_CornerPos[s][p];
+				for (uint st = 0u; st < 64u; st++)
+				{
+					sy_CornerStatus[s][p][st] = 0u;
+					if ((st & 0x8u) != 0u || (st >> 4) >= 3u) continue;
+					const Cube C = CornerProbe(p, st);
+					for (uint i = 0u; i < 3u; i++)
+					{
+						const uint Pos = FirstCornerSticker + 3u * p + i;
+						if (StickerMap[Pos] != FirstCornerSticker + 3u * q) continue;
+						sy_CornerStatus[s][p][st] = CornerFromSticker[q][StickerMap[static_cast<uint>(C.GetSticker(static_cast<StickerPositions>(Pos)))]];
+					}
+				}
+			}
+		}
+		return true;
+	}
+
+	// Get the cube status conjugated by the given symmetry (the cube seen rotated or mirrored, spin is not used)
+	Cube Cube::GetSymmetric(const uint Sym) const
+	{
+		Cube C;
+		C.edges = C.corners = 0ull;
+		for (uint p = 0u; p < 12u; p++)
+		{
+			const uint Status = static_cast<uint>(((edges >> (p << 2)) & 0xFull) | (((edges >> (p + 48u)) & 0x1ull) << 4));
+			const S64 NewStatus = sy_EdgeStatus[Sym][p][Status];
+			const uint q = sy_EdgePos[Sym][p];
+			C.edges |= ((NewStatus & 0xFull) << (q << 2)) | ((NewStatus >> 4) << (q + 48u));
 		}
+		for (uint p = 0u; p < 8u; p++)
+		{
+			const S64 NewStatus = sy_CornerStatus[Sym][p][(corners >> (p << 3)) & 0x37ull];
+			C.corners |= NewStatus << (sy_CornerPos[Sym][p] << 3);
+		}
+		return C;
+	}
+
+	// Get the canonical representative of the cube status under the 48 symmetries (the lowest edges and corners status)
+	Cube Cube::GetCanonical(uint& Sym) const
+	{
+		Cube Best(edges, corners);
+		Sym = 0u;
+		for (uint s = 1u; s < SYMMETRIES; s++)
+		{
+			const Cube C = GetSymmetric(s);
+			if (C.edges < Best.edges || (C.edges == Best.edges && C.corners < Best.corners))
+			{
+				Best = C;
+				Sym = s;
+			}
+		}
+		return Best;
+	}
+
+	// Get the single layer step equivalent to the given one after applying the given symmetry (mirrors invert the turn direction)
+	Steps Cube::GetSymmetricStep(const uint Sym, const Steps S)
+	{
+		if (S < Steps::U || S > Steps::L2) return S;
+
+		const uint Index = static_cast<uint>(S) - static_cast<uint>(Steps::U); // Three steps per face
+		uint Turn = Index % 3u; // Clockwise, counterclockwise, half turn
+		if (sy_Mirror[Sym] && Turn < 2u) Turn ^= 1u;
+
+		return static_cast<Steps>(static_cast<uint>(Steps::U) + 3u * static_cast<uint>(sy_Faces[Sym][Index / 3u]) + Turn);
 	}
 	
 	// Get the sticker in the given sticker position
@@ -1214,6 +953,14 @@ namespace grcube3
 
 	// Check if the cube is solved for the given group of pieces
 	bool Cube::IsSolved(const PiecesGroups SP) const
+	{
+		S64 EMask, CMask;
+		GetMasksSolved(SP, EMask, CMask);
+		return IsSolved(EMask, CMask);
+	}
+
+	// Get the edges and corners masks to check if a group of pieces is solved
+	void Cube::GetMasksSolved(const PiecesGroups SP, S64& EMask, S64& CMask)
 	{
 		std::vector<Pieces> PList;
 		std::vector<Edges> EList;
@@ -1226,7 +973,8 @@ namespace grcube3
 			else if (IsCorner(P)) CList.push_back(static_cast<Corners>(static_cast<int>(P) - static_cast<int>(Pieces::First_Corner)));
 		}
 
-		return IsSolved(GetMasksSolvedEdges(EList), GetMasksSolvedCorners(CList));
+		EMask = GetMasksSolvedEdges(EList);
+		CMask = GetMasksSolvedCorners(CList);
 	}
 
 	// Check if the cube is solved for the given groups of pieces
@@ -29,6 +29,16 @@
 
 namespace grcube3
 {
+	// Precompiled algorithm: the full effect of an algorithm over the cube, to be applied as a single operation
+	struct CubeTransform
+	{
+		Spins StartSpin, EndSpin; // Cube spin required to apply the transform and cube spin after it
+		uint EdgesSource[12]; // Source position of the edge in each position
+		S64 EdgesFlip; // Edges direction changes
+		uint CornersSource[8]; // Source position of the corner in each position
+		S64 CornersDir[8][3]; // New direction of the corner in each position for each previous direction
+	};
+
 	// 3x3x3 Rubik's cube class
 	class Cube: public c_Edges, public c_Corners
 	{
@@ -46,6 +56,9 @@ namespace grcube3
                 ApplyAlgorithm(Aux);
             }
 		}
+
+		// Edges and corners status constructor (default spin)
+		Cube(const S64 E, const S64 C) { edges = E; corners = C; spin = Spins::Default; }
 		
         // Get corners status
         S64 GetCornersStatus() const { return corners; }
@@ -184,66 +197,103 @@ namespace grcube3
 		void z2() { spin = s_Spins[static_cast<int>(spin)][8]; }
 
         // Cube U movement
-        void U();
+        void U() { Move(Steps::U); }
 
         // Cube U2 movement
-        void U2();
+        void U2() { Move(Steps::U2); }
 
         // Cube U' movement
-        void Up();
+        void Up() { Move(Steps::Up); }
 
         // Cube D movement
-        void D();
+        void D() { Move(Steps::D); }
 
         // Cube D2 movement
-        void D2();
+        void D2() { Move(Steps::D2); }
 
         // Cube D' movement
-        void Dp();
+        void Dp() { Move(Steps::Dp); }
 
         // Cube F movement
-        void F();
+        void F() { Move(Steps::F); }
 
         // Cube F2 movement
-        void F2();
+        void F2() { Move(Steps::F2); }
 
         // Cube F' movement
-        void Fp();
+        void Fp() { Move(Steps::Fp); }
 
         // Cube B movement
-        void B();
+        void B() { Move(Steps::B); }
 
         // Cube B2 movement
-        void B2();
+        void B2() { Move(Steps::B2); }
 
         // Cube B' movement
-        void Bp();
+        void Bp() { Move(Steps::Bp); }
 
         // Cube R movement
-        void R();
+        void R() { Move(Steps::R); }
 
         // Cube R2 movement
-        void R2();
+        void R2() { Move(Steps::R2); }
 
         // Cube R' movement
-        void Rp();
+        void Rp() { Move(Steps::Rp); }
 
         // Cube L movement
-        void L();
+        void L() { Move(Steps::L); }
 
         // Cube L2 movement
-        void L2();
+        void L2() { Move(Steps::L2); }
 
         // Cube L' movement
-        void Lp();
+        void Lp() { Move(Steps::Lp); }
 		
 		// Apply algorithm to cube (algorithm should not have parentheses with more than one repetition)
         // If there are parentheses with more than one repetition returns false and cube status remains unchanged
 		bool ApplyAlgorithm(Algorithm&);
 
+		// Get the precompiled transform of an algorithm, to be applied to cubes with the given spin
+		static CubeTransform GetTransform(Algorithm&, const Spins = Spins::Default);
+
+		// Apply a precompiled algorithm (fixed cost whatever the algorithm length)
+		// Returns false if the cube spin is not the transform start spin and cube status remains unchanged
+		bool ApplyTransform(const CubeTransform&);
+
+		// Number of cube symmetries (24 rotations and the 24 mirrors of them)
+		static constexpr uint SYMMETRIES = 48u;
+
+		// Get the cube status conjugated by the given symmetry (the cube seen rotated or mirrored, spin is not used)
+		Cube GetSymmetric(const uint) const;
+
+		// Get the canonical representative of the cube status under the 48 symmetries (spin is not used)
+		// The symmetry that maps the cube status to the representative is returned in the parameter
+		Cube GetCanonical(uint&) const;
+
+		// Get the single layer step equivalent to the given one after applying the given symmetry
+		static Steps GetSymmetricStep(const uint, const Steps);
+
+		// Check if the given symmetry is a mirror
+		static bool IsMirrorSymmetry(const uint Sym) { return sy_Mirror[Sym]; }
+
+		// 64 bits hash of the edges and corners status (spin is not used)
+		S64 GetHash() const
+		{
+			S64 h = edges ^ (corners * 0x9E3779B97F4A7C15ull);
+			h ^= h >> 33; h *= 0xFF51AFD7ED558CCDull; // Final mix from MurmurHash3
+			h ^= h >> 33; h *= 0xC4CEB9FE1A85EC53ull;
+			return h ^ (h >> 33);
+		}
+
 		// Apply movement (step) to the cube
 		// Returns false if the step is a close parentheses with more than one repetition
-		bool ApplyStep(const Steps);
+		bool ApplyStep(const Steps S)
+		{
+			// Fast path for single layer movements without spin (as used in the searches)
+			if (spin == Spins::UF && S >= Steps::U && S <= Steps::L2) { e_Move(S); c_Move(S); return true; }
+			return ApplyStepDispatch(S);
+		}
 
 		// Check if given piece is in given layer
 		bool IsPieceInLayer(const Pieces, const Layers) const;
@@ -275,6 +325,9 @@ namespace grcube3
         // Add pieces from groups of pieces to a list
 		static bool AddToPiecesList(const std::vector<PiecesGroups>&, std::vector<Pieces>&);
 
+        // Get the edges and corners masks to check if a group of pieces is solved
+		static void GetMasksSolved(const PiecesGroups, S64&, S64&);
+
         // Get the char for representing a layer
 		static char GetLayerChar(const Layers Ly) { return c_Layers[static_cast<uint>(Ly)]; }
 
@@ -294,6 +347,50 @@ namespace grcube3
 		// Array to follow spins when a cube has a turn (24x9 elements array)
 		const static Spins s_Spins[24][9]; 
 
+		// Number of steps in the dispatch table (from Steps::NONE to Steps::z2)
+		static constexpr uint DISPATCH_STEPS = static_cast<uint>(Steps::z2) + 1u;
+
+		// Struct to store the physical movements and the final spin for a step applied in a given spin
+		struct StepDispatch
+		{
+			Steps Move1, Move2; // Physical single layer movements (Steps::NONE if no movement)
+			Spins Spin; // Cube spin after the step
+		};
+
+		// Array to get the physical face turned by each face movement for each spin
+		const static Faces f_SpinFaces[24][6];
+
+		// Array with the face movements and the turn applied by each step
+		const static Steps s_StepsSequence[DISPATCH_STEPS][3];
+
+		// Dispatch table [spin][step] with the physical movements and the final spin
+		static StepDispatch s_Dispatch[24][DISPATCH_STEPS];
+		const static bool s_DispatchReady;
+
+		// Fill the dispatch table
+		static bool InitDispatch();
+
+		// Get the physical single layer step for the given single layer step in the given spin
+		static Steps GetPhysicalStep(const Spins, const Steps);
+
+		// Apply a single layer movement in the current spin
+		void Move(const Steps S) { const Steps P = s_Dispatch[static_cast<uint>(spin)][static_cast<uint>(S)].Move1; e_Move(P); c_Move(P); }
+
+		// Apply a step through the dispatch table
+		bool ApplyStepDispatch(const Steps);
+
+		// Symmetries tables: face, edge position and corner position after each symmetry
+		static Faces sy_Faces[48][6];
+		static uint sy_EdgePos[48][12], sy_CornerPos[48][8];
+		static bool sy_Mirror[48];
+
+		// Symmetries tables: new edge status (piece + direction << 4) and corner status (piece + direction << 4) for each position
+		static unsigned char sy_EdgeStatus[48][12][32], sy_CornerStatus[48][8][64];
+		const static bool sy_Ready;
+
+		// Fill the symmetries tables
+		static bool InitSymmetries();
+
         // Two turns array for get an spin from an inital spin
         const static Steps s_Turns[24][24][2];
 		
@@ -0,0 +1,263 @@
+/*  This file is part of "GR Cube"
+
+	Copyright (C) 2020 German Ramos Rodriguez
+
+	This program is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	This program is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+	German Ramos Rodriguez
+	Vigo, Spain
+	grvigo@hotmail.com
+*/
+
+#include <mutex>
+
+// AVX2 kernels: always used if the compiler targets AVX2, else compiled for AVX2 and selected in runtime (GCC and Clang in x86)
+#if defined(__AVX2__)
+#define GRCUBE_BATCH_AVX2
+#define GRCUBE_AVX2_TARGET
+#elif (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+#define GRCUBE_BATCH_AVX2
+#define GRCUBE_AVX2_TARGET __attribute__((target("avx2")))
+#endif
+
+#if defined(GRCUBE_BATCH_AVX2)
+#include <immintrin.h>
+#endif
+
+#include "cube_batch.h"
+
+namespace grcube3
+{
+	// Change the number of cubes (new cubes are solved)
+	void CubeBatch::Resize(const uint N)
+	{
+		const Cube Solved;
+		Size = N;
+		const uint Lanes = (N + 3u) & ~3u; // Multiple of four
+		EdgesStatus.resize(Lanes, Solved.GetEdgesStatus());
+		CornersStatus.resize(Lanes, Solved.GetCornersStatus());
+	}
+
+	// Store a cube status in the given lane
+	void CubeBatch::Set(const uint n, const Cube& C)
+	{
+		EdgesStatus[n] = C.GetEdgesStatus();
+		CornersStatus[n] = C.GetCornersStatus();
+	}
+
+	// AVX2 instructions used
+	bool CubeBatch::IsAVX2()
+	{
+#if defined(__AVX2__)
+		return true;
+#elif defined(GRCUBE_BATCH_AVX2)
+		static const bool AVX2 = []() { __builtin_cpu_init(); return __builtin_cpu_supports("avx2") != 0; }();
+		return AVX2;
+#else
+		return false;
+#endif
+	}
+
+	// Steps data, built from the single layer movements tables
+	const CubeBatch::BatchStep* CubeBatch::GetBatchSteps()
+	{
+		static BatchStep BSteps[19];
+		static std::once_flag BStepsFlag;
+
+		std::call_once(BStepsFlag, []()
+		{
+			for (uint m = 0u; m < 18u; m++)
+			{
+				BatchStep& B = BSteps[m];
+				B.EKeep = c_Edges::e_MovKeep[m];
+				B.EFlip = c_Edges::e_MovFlip[m];
+				B.CKeep = c_Corners::c_MovKeep[m];
+				B.CMoved = B.CFixed = 0ull;
+				for (uint n = 0u; n < 4u; n++)
+				{
+					const S64 es = static_cast<S64>(c_Edges::e_MovSrc[m][n]), ed = static_cast<S64>(c_Edges::e_MovDst[m][n]);
+					B.EPosSrc[n] = es << 2;
+					B.EPosDst[n] = ed << 2;
+					B.EDirSrc[n] = es + 48ull;
+					B.EDirDst[n] = ed + 48ull;
+					B.CSrc[n] = static_cast<S64>(c_Corners::c_MovSrc[m][n]) << 3;
+					B.CDst[n] = static_cast<S64>(c_Corners::c_MovDst[m][n]) << 3;
+				}
+				// Quarter turns swap two corner directions and keep the other one, half turns keep all directions
+				for (S64 d = 0ull; d < 3ull; d++)
+				{
+					if (c_Corners::c_MovDir[m][d] != d) continue;
+					if (c_Corners::c_MovDir[m][(d + 1ull) % 3ull] == (d + 1ull) % 3ull) break; // Directions not changed
+					for (uint n = 0u; n < 4u; n++)
+					{
+						B.CMoved |= 0x30ull << B.CDst[n];
+						B.CFixed |= (d << 4) << B.CDst[n];
+					}
+					break;
+				}
+			}
+			// No step (every moved piece stays in its own position)
+			BatchStep& B = BSteps[18];
+			B.EKeep = B.CKeep = ~0ull;
+			B.EFlip = B.CMoved = B.CFixed = 0ull;
+			for (uint n = 0u; n < 4u; n++)
+			{
+				B.EPosSrc[n] = B.EPosDst[n] = B.CSrc[n] = B.CDst[n] = 0ull;
+				B.EDirSrc[n] = B.EDirDst[n] = 48ull;
+			}
+		});
+
+		return BSteps;
+	}
+
+	// Index in steps data for the given step (no step index for not single layer steps)
+	uint CubeBatch::GetBatchStepIndex(const Steps S)
+	{
+		const uint s = static_cast<uint>(S);
+		if (s >= static_cast<uint>(Steps::U) && s <= static_cast<uint>(Steps::L2)) return s - static_cast<uint>(Steps::U);
+		return 18u;
+	}
+
+	// Apply a step to each one of four consecutive cubes
+	// The corners directions not fixed by the step are swapped: dir ^ (3 ^ fixed) when dir != fixed
+	void CubeBatch::ApplyLanes(S64* E, S64* C, const BatchStep* const* B)
+	{
+		for (uint l = 0u; l < 4u; l++)
+		{
+			const BatchStep& S = *B[l];
+			const S64 e = E[l], c = C[l];
+			S64 ne = e & S.EKeep, nc = c & S.CKeep;
+			for (uint n = 0u; n < 4u; n++)
+			{
+				ne |= ((e >> S.EPosSrc[n]) & 0xFull) << S.EPosDst[n];
+				ne |= ((e >> S.EDirSrc[n]) & 0x1ull) << S.EDirDst[n];
+				nc |= ((c >> S.CSrc[n]) & 0xFFull) << S.CDst[n];
+			}
+			const S64 y = (nc ^ S.CFixed) & S.CMoved;
+			S64 Change = (y | (y >> 1)) & S.CMoved & 0x1010101010101010ull;
+			Change |= Change << 1;
+			E[l] = ne ^ S.EFlip;
+			C[l] = nc ^ ((S.CFixed ^ S.CMoved) & Change);
+		}
+	}
+
+	// Apply a step to each one of four consecutive cubes with AVX2 instructions (only called if IsAVX2 is true)
+#if defined(GRCUBE_BATCH_AVX2)
+	GRCUBE_AVX2_TARGET void CubeBatch::ApplyLanesAVX2(S64* E, S64* C, const BatchStep* const* B)
+	{
+#define GR_LANES(F) _mm256_set_epi64x(static_cast<long long>(B[3]->F), static_cast<long long>(B[2]->F), \
+                                      static_cast<long long>(B[1]->F), static_cast<long long>(B[0]->F))
+		const __m256i e = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(E));
+		const __m256i c = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(C));
+		const __m256i Nibble = _mm256_set1_epi64x(0xF), Bit = _mm256_set1_epi64x(0x1), Byte = _mm256_set1_epi64x(0xFF);
+
+		__m256i ne = _mm256_and_si256(e, GR_LANES(EKeep)), nc = _mm256_and_si256(c, GR_LANES(CKeep));
+		for (uint n = 0u; n < 4u; n++)
+		{
+			ne = _mm256_or_si256(ne, _mm256_sllv_epi64(_mm256_and_si256(_mm256_srlv_epi64(e, GR_LANES(EPosSrc[n])), Nibble), GR_LANES(EPosDst[n])));
+			ne = _mm256_or_si256(ne, _mm256_sllv_epi64(_mm256_and_si256(_mm256_srlv_epi64(e, GR_LANES(EDirSrc[n])), Bit), GR_LANES(EDirDst[n])));
+			nc = _mm256_or_si256(nc, _mm256_sllv_epi64(_mm256_and_si256(_mm256_srlv_epi64(c, GR_LANES(CSrc[n])), Byte), GR_LANES(CDst[n])));
+		}
+		ne = _mm256_xor_si256(ne, GR_LANES(EFlip));
+
+		const __m256i Moved = GR_LANES(CMoved), Fixed = GR_LANES(CFixed);
+		const __m256i y = _mm256_and_si256(_mm256_xor_si256(nc, Fixed), Moved);
+		__m256i Change = _mm256_and_si256(_mm256_or_si256(y, _mm256_srli_epi64(y, 1)), _mm256_and_si256(Moved, _mm256_set1_epi64x(0x1010101010101010)));
+		Change = _mm256_or_si256(Change, _mm256_slli_epi64(Change, 1));
+		nc = _mm256_xor_si256(nc, _mm256_and_si256(_mm256_xor_si256(Fixed, Moved), Change));
+
+		_mm256_storeu_si256(reinterpret_cast<__m256i*>(E), ne);
+		_mm256_storeu_si256(reinterpret_cast<__m256i*>(C), nc);
+#undef GR_LANES
+	}
+#else
+	void CubeBatch::ApplyLanesAVX2(S64* E, S64* C, const BatchStep* const* B) { ApplyLanes(E, C, B); }
+#endif
+
+	// Apply the same step to all cubes (false if the step is not a single layer step)
+	bool CubeBatch::ApplyStep(const Steps S)
+	{
+		const uint Index = GetBatchStepIndex(S);
+		if (Index >= 18u) return false;
+
+		const BatchStep* B = GetBatchSteps() + Index;
+		const BatchStep* const Lanes[4] = { B, B, B, B };
+		if (IsAVX2()) for (uint n = 0u; n < Size; n += 4u) ApplyLanesAVX2(EdgesStatus.data() + n, CornersStatus.data() + n, Lanes);
+		else for (uint n = 0u; n < Size; n += 4u) ApplyLanes(EdgesStatus.data() + n, CornersStatus.data() + n, Lanes);
+		return true;
+	}
+
+	// Apply a step to each cube (Steps::NONE or not single layer steps leave the cube unchanged)
+	void CubeBatch::ApplySteps(const std::vector<Steps>& SV)
+	{
+		const BatchStep* BSteps = GetBatchSteps();
+		const BatchStep* Lanes[4];
+		const bool AVX2 = IsAVX2();
+		for (uint n = 0u; n < Size; n += 4u)
+		{
+			for (uint l = 0u; l < 4u; l++)
+				Lanes[l] = BSteps + (n + l < Size && n + l < SV.size() ? GetBatchStepIndex(SV[n + l]) : 18u);
+			if (AVX2) ApplyLanesAVX2(EdgesStatus.data() + n, CornersStatus.data() + n, Lanes);
+			else ApplyLanes(EdgesStatus.data() + n, CornersStatus.data() + n, Lanes);
+		}
+	}
+
+	// Check which cubes are solved for the given edges and corners masks (a flag for each cube)
+	// Returns the number of solved cubes
+	uint CubeBatch::IsSolved(const S64 EMask, const S64 CMask, std::vector<bool>& Solved) const
+	{
+		const S64 ESolved = c_Edges::EMASK_SOLVED & EMask, CSolved = c_Corners::CMASK_SOLVED & CMask;
+		const bool AVX2 = IsAVX2();
+		uint Count = 0u;
+
+		Solved.resize(Size);
+		for (uint n = 0u; n < Size; n += 4u)
+		{
+			const uint Flags = AVX2 ? GetSolvedLanesAVX2(EdgesStatus.data() + n, CornersStatus.data() + n, EMask, ESolved, CMask, CSolved) :
+									  GetSolvedLanes(EdgesStatus.data() + n, CornersStatus.data() + n, EMask, ESolved, CMask, CSolved);
+			for (uint l = 0u; l < 4u && n + l < Size; l++)
+			{
+				Solved[n + l] = ((Flags >> l) & 1u) != 0u;
+				if (Solved[n + l]) Count++;
+			}
+		}
+		return Count;
+	}
+
+	// Solved flags (a bit for each cube) of four consecutive cubes for the given masks and solved status
+	uint CubeBatch::GetSolvedLanes(const S64* E, const S64* C, const S64 EMask, const S64 ESolved, const S64 CMask, const S64 CSolved)
+	{
+		uint Flags = 0u;
+		for (uint l = 0u; l < 4u; l++)
+			if ((E[l] & EMask) == ESolved && (C[l] & CMask) == CSolved) Flags |= 1u << l;
+		return Flags;
+	}
+
+	// Solved flags of four consecutive cubes with AVX2 instructions (only called if IsAVX2 is true)
+#if defined(GRCUBE_BATCH_AVX2)
+	GRCUBE_AVX2_TARGET uint CubeBatch::GetSolvedLanesAVX2(const S64* E, const S64* C, const S64 EMask, const S64 ESolved, const S64 CMask, const S64 CSolved)
+	{
+		const __m256i e = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(E));
+		const __m256i c = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(C));
+		const __m256i se = _mm256_cmpeq_epi64(_mm256_and_si256(e, _mm256_set1_epi64x(static_cast<long long>(EMask))), _mm256_set1_epi64x(static_cast<long long>(ESolved)));
+		const __m256i sc = _mm256_cmpeq_epi64(_mm256_and_si256(c, _mm256_set1_epi64x(static_cast<long long>(CMask))), _mm256_set1_epi64x(static_cast<long long>(CSolved)));
+		return static_cast<uint>(_mm256_movemask_pd(_mm256_castsi256_pd(_mm256_and_si256(se, sc))));
+	}
+#else
+	uint CubeBatch::GetSolvedLanesAVX2(const S64* E, const S64* C, const S64 EMask, const S64 ESolved, const S64 CMask, const S64 CSolved)
+	{
+		return GetSolvedLanes(E, C, EMask, ESolved, CMask, CSolved);
+	}
+#endif
+}
@@ -0,0 +1,90 @@
+/*  This file is part of "GR Cube"
+
+	Copyright (C) 2020 German Ramos Rodriguez
+
+	This program is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	This program is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+	German Ramos Rodriguez
+	Vigo, Spain
+	grvigo@hotmail.com
+*/
+
+#pragma once
+
+#include <vector>
+
+#include "cube_definitions.h"
+#include "cube.h"
+
+namespace grcube3
+{
+	// Group of cubes stored in structure of arrays layout (all edges status together, all corners status together)
+	// Steps are applied to all cubes at once (four cubes per instruction if the processor supports AVX2, checked in runtime)
+	// Only single layer steps (from Steps::U to Steps::L2) are supported and cubes spin is not stored
+	// Library class for bulk cube evaluations: the CFOP searches score each solve as it's found, so they don't use it
+	class CubeBatch
+	{
+	public:
+		CubeBatch(const uint N = 0u) { Resize(N); } // Batch with N solved cubes
+
+		uint GetSize() const { return Size; } // Number of cubes in the batch
+
+		void Resize(const uint); // Change the number of cubes (new cubes are solved)
+		void Set(const uint, const Cube&); // Store a cube status in the given lane
+		void Add(const Cube& C) { Resize(Size + 1u); Set(Size - 1u, C); } // Add a cube at the end of the batch
+
+		Cube Get(const uint n) const { return Cube(EdgesStatus[n], CornersStatus[n]); } // Get the cube in the given lane
+		S64 GetEdgesStatus(const uint n) const { return EdgesStatus[n]; }
+		S64 GetCornersStatus(const uint n) const { return CornersStatus[n]; }
+
+		// Apply the same step to all cubes (false if the step is not a single layer step)
+		bool ApplyStep(const Steps);
+
+		// Apply a step to each cube (Steps::NONE or not single layer steps leave the cube unchanged)
+		void ApplySteps(const std::vector<Steps>&);
+
+		// Check which cubes are solved for the given edges and corners masks (a flag for each cube)
+		// Returns the number of solved cubes
+		uint IsSolved(const S64, const S64, std::vector<bool>&) const;
+
+		static bool IsAVX2(); // AVX2 instructions used (supported by the compiler and the processor)
+
+	private:
+		friend struct CFOPTests; // Scalar and AVX2 kernels checks (cfop_tests)
+
+		// Data for a single layer step, with shifts as 64 bits values to be loaded directly in vector registers
+		struct BatchStep
+		{
+			S64 EKeep, EFlip; // Edges not affected and edges directions inverted
+			S64 EPosSrc[4], EPosDst[4], EDirSrc[4], EDirDst[4]; // Edges positions and directions shifts
+			S64 CKeep; // Corners not affected
+			S64 CSrc[4], CDst[4]; // Corners shifts
+			S64 CMoved, CFixed; // Direction bits of the moved corners, and direction that the step does not change
+		};
+
+		uint Size; // Number of cubes
+		std::vector<S64> EdgesStatus, CornersStatus; // Cubes status (size rounded up to a multiple of four)
+
+		static const BatchStep* GetBatchSteps(); // Steps data (18 single layer steps + no step)
+		static uint GetBatchStepIndex(const Steps); // Index in steps data for the given step
+
+		// Apply a step to each one of four consecutive cubes (without and with AVX2 instructions)
+		static void ApplyLanes(S64*, S64*, const BatchStep* const*);
+		static void ApplyLanesAVX2(S64*, S64*, const BatchStep* const*);
+
+		// Solved flags (a bit for each cube) of four consecutive cubes for the given masks and solved status
+		static uint GetSolvedLanes(const S64*, const S64*, const S64, const S64, const S64, const S64);
+		static uint GetSolvedLanesAVX2(const S64*, const S64*, const S64, const S64, const S64, const S64);
+	};
+}
@@ -22,58 +22,105 @@
 
 #include <thread>
 #include <mutex>
+#include <algorithm>
 
 #include "deep_search.h"
+#include "thread_pool.h"
+#include "cube_batch.h"
 
 namespace grcube3
 {
-    // Algorithm search class constructor
-    // Scramble to start the search
-    // Goups of pieces to check (wich pieces have to be solved for finishing the search)
-    // What kind of search has to be done in each search level
-    // If OptimizeThreads is true (and exist the conditions to optimize threads), the first search level never will be checked
-    // If multiple search is enabled, each pieces group will be checked separatelly. If disabled, all pieces groups are evaluated together
-    DeepSearch::DeepSearch(Algorithm& Scr, std::vector<PiecesGroups>& SP, std::vector<SearchLevel>& SL, bool OptimizeThreads, bool MultipleSearch)
-	{	
-		std::vector<Pieces> PiecesList; // Pieces list to solve
-        std::vector<Edges> EdgesList; // Edges list to solve
-        std::vector<Corners> CornersList; // Corners list to solve
+	// Automaton shared by all searches (built the first time is requested)
+	const CanonicalSteps& CanonicalSteps::Get()
+	{
+		static const CanonicalSteps CS;
+		return CS;
+	}
+
+	// Build the automaton from the Algorithm rules, merging the equivalent states
+	// Start with a state for each pair of last steps, then merge the states with the same allowed steps and the same next states
+	CanonicalSteps::CanonicalSteps()
+	{
+		const uint Pairs = STEPS * STEPS; // Pair index = penultimate step * STEPS + last step
+		std::vector<std::array<bool, STEPS>> PairAllowed(Pairs);
+		for (uint p = 0u; p < Pairs; p++)
+		{
+			const Steps Prev2 = static_cast<Steps>(p / STEPS), Prev1 = static_cast<Steps>(p % STEPS);
+			for (uint s = 0u; s < STEPS; s++)
+			{
+				const Steps S = static_cast<Steps>(s);
+				PairAllowed[p][s] = !(Algorithm::OppositeSteps(Prev1, S) && Prev1 > S) && !Algorithm::ShrinkableSteps(Prev2, Prev1, S);
+			}
+		}
+
+		// Pairs reachable from the empty path
+		std::vector<bool> Reachable(Pairs, false);
+		std::vector<uint> Pending(1u, 0u);
+		Reachable[0] = true;
+		while (!Pending.empty())
+		{
+			const uint p = Pending.back();
+			Pending.pop_back();
+			for (uint s = 0u; s < STEPS; s++)
+			{
+				const uint np = (p % STEPS) * STEPS + s;
+				if (!Reachable[np]) { Reachable[np] = true; Pending.push_back(np); }
+			}
+		}
 
-		if (MultipleSearch) // Each piece group generates a solve mask pair (edges and corners)
+		// Refine the states classes until the number of classes is stable (Moore algorithm)
+		std::vector<uint> Class(Pairs, 0u);
+		uint Classes = 0u;
+		while (true)
 		{
-			for (auto s : SP)
+			std::vector<std::vector<uint>> Keys;
+			std::vector<uint> NewClass(Pairs, 0u);
+			for (uint p = 0u; p < Pairs; p++)
 			{
-				PiecesList.clear();
-				Cube::AddToPiecesList(s, PiecesList); // Each piece group
-				EdgesList.clear();
-				CornersList.clear();
-				for (auto P : PiecesList) // Separate pieces in edges and corners
+				if (!Reachable[p]) continue;
+				std::vector<uint> Key(1u, Class[p]);
+				for (uint s = 0u; s < STEPS; s++) // Allowed step and next state class (also for not allowed steps, used in paths not created by the search)
 				{
-					if (Cube::IsEdge(P))
-						EdgesList.push_back(static_cast<Edges>(static_cast<int>(P) - static_cast<int>(Pieces::First_Edge)));
-					else if (Cube::IsCorner(P))
-						CornersList.push_back(static_cast<Corners>(static_cast<int>(P) - static_cast<int>(Pieces::First_Corner)));
+					Key.push_back(PairAllowed[p][s] ? 1u : 0u);
+					Key.push_back(Class[(p % STEPS) * STEPS + s]);
 				}
-				MasksPair MP(Cube::GetMasksSolvedEdges(EdgesList), Cube::GetMasksSolvedCorners(CornersList));
-				SolveMasks.push_back(MP);
+				const auto it = std::find(Keys.begin(), Keys.end(), Key);
+				NewClass[p] = static_cast<uint>(it - Keys.begin());
+				if (it == Keys.end()) Keys.push_back(Key);
 			}
+			Class = NewClass;
+			if (Keys.size() == Classes) break;
+			Classes = static_cast<uint>(Keys.size());
 		}
-        else // All pieces in a pair of masks (edges + corners)
+
+		Start = Class[0];
+		Next.resize(Classes);
+		NextAny.resize(Classes);
+		for (uint p = 0u; p < Pairs; p++)
 		{
-			for (auto s : SP) Cube::AddToPiecesList(s, PiecesList); // No multimple search, all pieces together
-			
-			for (auto P : PiecesList) // Separate pieces in edges and corners
+			if (!Reachable[p]) continue;
+			for (uint s = 0u; s < STEPS; s++)
 			{
-				if (Cube::IsEdge(P))
-					EdgesList.push_back(static_cast<Edges>(static_cast<int>(P) - static_cast<int>(Pieces::First_Edge)));
-				else if (Cube::IsCorner(P))
-					CornersList.push_back(static_cast<Corners>(static_cast<int>(P) - static_cast<int>(Pieces::First_Corner)));
+				const uint np = (p % STEPS) * STEPS + s;
+				NextAny[Class[p]][s] = static_cast<unsigned char>(Class[np]);
+				Next[Class[p]][s] = static_cast<unsigned char>(PairAllowed[p][s] ? Class[np] : REJECT);
 			}
-			MasksPair MP(Cube::GetMasksSolvedEdges(EdgesList), Cube::GetMasksSolvedCorners(CornersList));
-			SolveMasks.push_back(MP);
 		}
+	}
+
+    // Algorithm search class constructor
+    // Scramble to start the search
+    // Goups of pieces to check (wich pieces have to be solved for finishing the search)
+    // What kind of search has to be done in each search level
+    // If OptimizeThreads is true (and exist the conditions to optimize threads), the first search level never will be checked
+    // If multiple search is enabled, each pieces group will be checked separatelly. If disabled, all pieces groups are evaluated together
+    DeepSearch::DeepSearch(const Algorithm& Scr, const std::vector<PiecesGroups>& SP, std::vector<SearchLevel>& SL, bool OptimizeThreads, bool MultipleSearch)
+	{	
+		if (MultipleSearch) for (auto s : SP) SolveMasks.push_back(GetSolveMasks({ s })); // Each piece group generates a solve mask pair (edges and corners)
+		else SolveMasks.push_back(GetSolveMasks(SP)); // No multimple search, all pieces together in a pair of masks (edges + corners)
 
         MaxSearchDeep = static_cast<uint>(SL.size()); // Maximum search deep is the number of levels in the search levels vector
+		if (MaxSearchDeep > SearchPath::MAX_STEPS) MaxSearchDeep = SearchPath::MAX_STEPS;
 
         std::vector<std::vector<Steps>> AuxLevelSteps; // Double vector to store steps to be used in each level
 
@@ -90,6 +137,24 @@ namespace grcube3
 			if (SL[level].SAction == SearchActions::STEPS_LIST) Algorithm::AddToStepsList(SL[level].SSteps, AuxLevelSteps[level]);
 			LevelsSteps.push_back(AuxLevelSteps[level]);
 		}
+
+        // Allowed branches for each level and canonical steps automaton state
+		const CanonicalSteps& CS = CanonicalSteps::Get();
+		LevelsChildren.resize(MaxSearchDeep);
+		for (uint level = 0; level < MaxSearchDeep; level++)
+		{
+			LevelsChildren[level].resize(CS.GetStates());
+			for (uint State = 0u; State < CS.GetStates(); State++)
+			{
+				for (uint b = 0u; b < LevelsSteps[level].size(); b++)
+				{
+					const Steps S = LevelsSteps[level][b];
+					if (S == Steps::NONE) LevelsChildren[level][State].push_back({ b, S, State }); // Same path
+					else if (S < static_cast<Steps>(CanonicalSteps::STEPS) && CS.GetNext(State, S) != CanonicalSteps::REJECT)
+						LevelsChildren[level][State].push_back({ b, S, CS.GetNext(State, S) });
+				}
+			}
+		}
 		
         // Apply the scramble
 		Scramble = Scr;
@@ -129,198 +194,467 @@ namespace grcube3
         if (RootBranches < 1u) RootBranches = 1u; // Should not happend
 
 		UsedCores = 0; // Not used cored yet
+		PendingTasks = 0u;
+		IdleWorkers = 0u;
+		TranspositionsLevel = 0u;
+		UseTranspositions = false;
+		TableHits = TableMisses = 0ull;
+		Nodes = 0ull;
+		Cancel = nullptr;
+		Deadline = std::chrono::steady_clock::time_point::max();
+		NodesLimit = 0ull;
+		LimitNodes = 0ull;
+		Interrupted = false;
+		LengthLimit = nullptr;
 	}
 	
+	// Search class constructor from a cube state instead of a scramble, for a multiple search with the given solve groups
+	// (the pieces groups in each solve group are evaluated together)
+	DeepSearch::DeepSearch(const Cube& C, const std::vector<std::vector<PiecesGroups>>& SG, std::vector<SearchLevel>& SL) :
+		DeepSearch(Algorithm(), std::vector<PiecesGroups>(), SL)
+	{
+		CubeBase = C;
+		SolveMasks.clear();
+		for (const auto& G : SG) SolveMasks.push_back(GetSolveMasks(G));
+	}
+
+	// Get the solve masks pair (edges and corners) for all the pieces in the pieces groups
+	MasksPair DeepSearch::GetSolveMasks(const std::vector<PiecesGroups>& SP)
+	{
+		std::vector<Pieces> PiecesList; // Pieces list to solve
+        std::vector<Edges> EdgesList; // Edges list to solve
+        std::vector<Corners> CornersList; // Corners list to solve
+
+		for (auto s : SP) Cube::AddToPiecesList(s, PiecesList);
+
+		for (auto P : PiecesList) // Separate pieces in edges and corners
+		{
+			if (Cube::IsEdge(P))
+				EdgesList.push_back(static_cast<Edges>(static_cast<int>(P) - static_cast<int>(Pieces::First_Edge)));
+			else if (Cube::IsCorner(P))
+				CornersList.push_back(static_cast<Corners>(static_cast<int>(P) - static_cast<int>(Pieces::First_Corner)));
+		}
+		return MasksPair(Cube::GetMasksSolvedEdges(EdgesList), Cube::GetMasksSolvedCorners(CornersList));
+	}
+
+	// Use pruning tables to skip the branches that can't solve any pieces group in the remaining levels
+	bool DeepSearch::SetCrossPruning()
+	{
+		PruningTables.clear();
+
+		// Each search level must add a single layer movement at most (the tables distances are in single layer movements)
+		for (uint level = 0; level < MaxSearchDeep; level++)
+		{
+			if (LevelsActions[level] != SearchActions::STEPS_LIST && LevelsActions[level] != SearchActions::OPPOSITE_STEP_2_PREVIOUS) return false;
+			for (auto S : LevelsSteps[level]) if (S != Steps::NONE && (S < Steps::U || S > Steps::L2)) return false;
+		}
+
+		std::vector<const CrossPruningTable*> Tables;
+		for (const auto& M : SolveMasks)
+		{
+			const CrossPruningTable* T = M.MaskC == 0ull ? CrossPruningTable::Get(M.MaskE) : nullptr;
+			if (T == nullptr) return false; // Not a cross
+			Tables.push_back(T);
+		}
+		PruningTables = Tables;
+		return true;
+	}
+
+	// Use a transposition table with the given memory budget (megabytes) to skip the cube states already searched (0 to disable)
+	bool DeepSearch::SetTranspositionTable(const uint MegaBytes)
+	{
+		Transpositions.reset();
+		if (MegaBytes == 0u) return true;
+
+		// A subtree only depends on the cube state if all the levels below use the same steps list and check
+		uint First = MaxSearchDeep;
+		while (First > 0u && LevelsActions[First - 1u] == SearchActions::STEPS_LIST &&
+			   (First == MaxSearchDeep || (LevelsSteps[First - 1u] == LevelsSteps[First] && LevelsCheck[First - 1u] == LevelsCheck[First]))) First--;
+		if (First + TRANSPOSITIONS_MIN_LEVELS > MaxSearchDeep) return false; // Nothing to skip
+
+		Transpositions.reset(new TranspositionTable(MegaBytes));
+		TranspositionsLevel = First;
+		return true;
+	}
+
 	// Run the search - -1: use no threads, 0: use all threads avaliable, other: use specified number of threads
 	void DeepSearch::Run(const int UseThreads)
 	{
-		if (UseThreads >= 0) // Multithreading
-		{
-			UsedCores = (UseThreads == 0) || (UseThreads >= Cores) ? Cores : UseThreads;
+		UsedCores = GetThreadsNumber(UseThreads); // A single thread without multithreading (for debugging, slower)
 
-			std::vector<std::thread> Pool; // Threads pool
+		const auto time_search_start = std::chrono::steady_clock::now();
 
-			for (uint nc = 0; nc < UsedCores; nc++) Pool.push_back(std::thread(&DeepSearch::RunThread, this, nc)); // Add a thread per core
-			for (auto& t : Pool) t.join(); // Wait for all threads
+		// Distribute the root branches among the workers queues
+		Workers.reset(new SearchWorker[UsedCores]);
+		for (uint nc = 0u; nc < UsedCores; nc++)
+		{
+			Workers[nc].Thread = nc;
+			if (SearchStats::ENABLED) Workers[nc].Levels.resize(MaxSearchDeep);
+		}
+		uint Tasks = 0u;
+		for (uint n = 0; n < RootBranches && n < FirstLevelAlgs.size(); n++)
+		{
+			SearchTask T;
+			T.Path = SearchPath(FirstLevelAlgs[n]);
+			T.Path.SetBranch(0u, n);
+			T.Path.SetBranch(1u, 0u);
+			T.CubeTask = CubeBase;
+			T.CubeTask.ApplyAlgorithm(FirstLevelAlgs[n]);
+			T.Deep = ExtendFirstLevel ? 1u : 0u; // Start search in deep 1 if levels 0 and 1 are merged -first level is not checked-
+			T.GroupMask = GetStartGroupMask();
+			Workers[n % UsedCores].Tasks.push_front(T);
+			Tasks++;
 		}
-        else // Without multithreading (for debugging, slower)
+		PendingTasks = QueuedTasks = Tasks;
+		IdleWorkers = 0u;
+		UseTranspositions = Transpositions && UseThreads < 0; // With threads the first path to a state depends on the timing
+		if (UseTranspositions) Transpositions->Clear();
+		LimitNodes = 0ull;
+		Interrupted = false;
+		if (IsLimited()) CheckLimits(0ull); // The search could be cancelled or out of time before starting
+
+		// A search job per core in the process-wide threads pool
+		if (UseThreads >= 0) ThreadPool::Get().Run(UsedCores, [this](const uint nc) { RunThread(nc); });
+		else RunThread(0u);
+
+		MergeSolves();
+		TableHits = TableMisses = Nodes = 0ull;
+		Stats = SearchStats();
+		if (SearchStats::ENABLED) Stats.Levels.resize(MaxSearchDeep);
+		for (uint nc = 0u; nc < UsedCores; nc++)
 		{
-			for (uint n = 0; n < RootBranches; n++)
+			TableHits += Workers[nc].TableHits;
+			TableMisses += Workers[nc].TableMisses;
+			Nodes += Workers[nc].Nodes;
+			Stats.ThreadsNodes.push_back(Workers[nc].Nodes);
+			Stats.ThreadsBusyTime.push_back(Workers[nc].BusyTime);
+			for (uint level = 0u; level < Workers[nc].Levels.size(); level++)
 			{
-				if (ExtendFirstLevel) RunSearch(FirstLevelAlgs[n], 1u, GetStartGroupMask());
-				else RunSearch(FirstLevelAlgs[n], 0u, GetStartGroupMask());
+				const LevelStats& L = Workers[nc].Levels[level];
+				Stats.Levels[level].Nodes += L.Nodes;
+				Stats.Levels[level].Checks += L.Checks;
+				Stats.Levels[level].Pruned += L.Pruned;
+				Stats.Levels[level].Transpositions += L.Transpositions;
+				Stats.Levels[level].Solves += L.Solves;
 			}
-			UsedCores = -1;
+		}
+		Workers.reset();
+		Stats.Time = std::chrono::duration<double>(std::chrono::steady_clock::now() - time_search_start).count();
+
+		if (UseThreads < 0) UsedCores = -1;
+	}
+
+	// Interrupt the search if it has been cancelled, the deadline has been reached or the nodes budget has been spent
+	// Each thread calls it every LIMITS_CHECK_NODES nodes, so the nodes budget is approximate
+	void DeepSearch::CheckLimits(const S64 NewNodes)
+	{
+		if ((Cancel != nullptr && Cancel->IsCancelled()) ||
+			(NodesLimit > 0ull && (LimitNodes += NewNodes) >= NodesLimit) ||
+			(Deadline != std::chrono::steady_clock::time_point::max() && std::chrono::steady_clock::now() >= Deadline))
+			Interrupted.store(true, std::memory_order_relaxed);
+	}
+
+	// Merge the workers solves in the search tree order, so the result is the same whatever the threads timing
+	void DeepSearch::MergeSolves()
+	{
+		std::vector<SearchSolve> AllSolves;
+		for (uint nc = 0u; nc < UsedCores; nc++)
+			for (auto& S : Workers[nc].Solves) AllSolves.push_back(std::move(S));
+
+		// Solves in the same node are already in the pieces groups order
+		std::stable_sort(AllSolves.begin(), AllSolves.end(), [](const SearchSolve& S1, const SearchSolve& S2) { return S1.Order < S2.Order; });
+
+		for (auto& S : AllSolves)
+		{
+			Solves.push_back(std::move(S.Solve));
+			SolvesCubes.push_back(S.CubeSolve);
 		}
 	}
 	
-    // Run search a thread
+    // Run search tasks in a thread until all tasks are done
 	void DeepSearch::RunThread(const uint NCore)
 	{	
-		for (uint n = NCore; n < RootBranches; n += UsedCores)
+		SearchTask T;
+		bool Idle = false;
+		uint Spins = 0u;
+
+		while (PendingTasks > 0u)
 		{
-            if (ExtendFirstLevel) RunSearch(FirstLevelAlgs[n], 1u, GetStartGroupMask()); // Start search in deep 1 (as levels 0 and 1 are merged) -first level is not checked-
-            else RunSearch(FirstLevelAlgs[n], 0u, GetStartGroupMask()); // Start search in deep level 0
+			if (PopTask(NCore, T) || StealTask(NCore, T))
+			{
+				if (Idle) { IdleWorkers--; Idle = false; }
+				Spins = 0u;
+				const auto time_task_start = std::chrono::steady_clock::now();
+				RunSearch(T.Path, T.CubeTask, T.Deep, T.GroupMask, Workers[NCore]);
+				Workers[NCore].BusyTime += std::chrono::duration<double>(std::chrono::steady_clock::now() - time_task_start).count();
+				if (--PendingTasks == 0u) NotifyIdle(true); // New tasks from this branch have been already added
+			}
+			else
+			{
+				if (!Idle) { IdleWorkers++; Idle = true; }
+				// Short back-off, then wait (without using the core, as the pool threads are shared) for a new task or the search end
+				if (++Spins < IDLE_SPINS) std::this_thread::yield();
+				else
+				{
+					std::unique_lock<std::mutex> lock(IdleMutex);
+					IdleCondition.wait(lock, [this] { return PendingTasks == 0u || QueuedTasks > 0u; });
+				}
+			}
 		}
+		if (Idle) IdleWorkers--;
     }
+
+	// Wake up one idle thread (a new task has been queued) or all of them (the search has finished)
+	// The mutex is locked before the notification, so a thread checking the wait condition can't miss it
+	void DeepSearch::NotifyIdle(const bool All)
+	{
+		{
+			std::lock_guard<std::mutex> guard(IdleMutex);
+		}
+		if (All) IdleCondition.notify_all();
+		else IdleCondition.notify_one();
+	}
+
+	// Get a task from the worker own queue (last added task)
+	bool DeepSearch::PopTask(const uint NCore, SearchTask& T)
+	{
+		SearchWorker& W = Workers[NCore];
+		std::lock_guard<std::mutex> guard(W.QueueMutex);
+		if (W.Tasks.empty()) return false;
+		T = W.Tasks.back();
+		W.Tasks.pop_back();
+		QueuedTasks--;
+		return true;
+	}
+
+	// Get a task from the queue of other worker (oldest task, usually the biggest branch)
+	bool DeepSearch::StealTask(const uint NCore, SearchTask& T)
+	{
+		for (uint n = 1u; n < UsedCores; n++)
+		{
+			SearchWorker& W = Workers[(NCore + n) % UsedCores];
+			std::lock_guard<std::mutex> guard(W.QueueMutex);
+			if (W.Tasks.empty()) continue;
+			T = W.Tasks.front();
+			W.Tasks.pop_front();
+			QueuedTasks--;
+			return true;
+		}
+		return false;
+	}
+
+	// If there are idle threads, send the branch to the worker queue instead of searching it now
+	bool DeepSearch::SplitBranch(SearchWorker& W, const SearchPath& Path, const Cube& CubeBranch, const uint Deep, const M16 GroupMask)
+	{
+		if (IdleWorkers == 0u || Deep + SPLIT_MIN_LEVELS > MaxSearchDeep) return false;
+
+		SearchTask T;
+		T.Path = Path;
+		T.CubeTask = CubeBranch;
+		T.Deep = Deep;
+		T.GroupMask = GroupMask;
+
+		PendingTasks++;
+		{
+			std::lock_guard<std::mutex> guard(W.QueueMutex);
+			W.Tasks.push_back(T);
+			QueuedTasks++;
+		}
+		NotifyIdle(false);
+		return true;
+	}
     
 	// Recursive search code
-    void DeepSearch::RunSearch(Algorithm& Alg, uint Deep, M16 GroupMask)
+	// CubeAlg is the cube state after applying the scramble and the current path, so each new branch only applies one step
+	// The path is a fixed-capacity steps stack, an algorithm is only created when a solve is found
+	// Child branches can be sent to the worker queue to be stolen by idle threads, solves are stored in the worker buffer
+    void DeepSearch::RunSearch(SearchPath& Path, const Cube& CubeAlg, uint Deep, M16 GroupMask, SearchWorker& W)
 	{
-		if (Deep >= MaxSearchDeep || GroupMask == 0u) return;
+		if (Deep >= MaxSearchDeep || GroupMask == 0u || Interrupted.load(std::memory_order_relaxed)) return;
+		if ((++W.Nodes & (LIMITS_CHECK_NODES - 1ull)) == 0ull && IsLimited()) CheckLimits(LIMITS_CHECK_NODES);
+		if (SearchStats::ENABLED) W.Levels[Deep].Nodes++;
+
+		// Skip the branch if the solves in it are too long to improve the best solves already found
+		if (LengthLimit != nullptr && Path.GetSize() > LengthLimit->load(std::memory_order_relaxed))
+		{
+			if (SearchStats::ENABLED) W.Levels[Deep].Pruned++;
+			return;
+		}
+
+		// Skip the branch if the pieces can't be solved in the remaining levels (a movement per level)
+		if (!PruningTables.empty() && !IsInRange(CubeAlg, MaxSearchDeep - 1u - Deep, GroupMask))
+		{
+			if (SearchStats::ENABLED) W.Levels[Deep].Pruned++;
+			return;
+		}
+
+		// Skip the branch if the cube state has been searched before with the same or more remaining levels
+		if (UseTranspositions && Deep >= TranspositionsLevel && Deep + TRANSPOSITIONS_MIN_LEVELS <= MaxSearchDeep)
+		{
+			if (Transpositions->Visit(CubeAlg, GroupMask, MaxSearchDeep - Deep))
+			{
+				W.TableHits++;
+				if (SearchStats::ENABLED) W.Levels[Deep].Transpositions++;
+				return;
+			}
+			W.TableMisses++;
+		}
 
         // Check if current algorithm solves the pieces
 		if (LevelsCheck[Deep] == SearchCheck::CHECK)
 		{
-			Cube CubeTest = CubeBase;
-			CubeTest.ApplyAlgorithm(Alg);
-
 			M16 iMask = 1u;
+			uint Group = 0u;
 			for (const auto& M : SolveMasks)
 			{
-				if (((GroupMask & iMask) > 0u) && CubeTest.IsSolved(M.MaskE, M.MaskC))
+				if (SearchStats::ENABLED && (GroupMask & iMask) > 0u) W.Levels[Deep].Checks++;
+				if (((GroupMask & iMask) > 0u) && CubeAlg.IsSolved(M.MaskE, M.MaskC))
 				{ // Solve algorithm found
+					if (SearchStats::ENABLED) W.Levels[Deep].Solves++;
 					GroupMask &= ~iMask; // The search for this group is complete
-					std::lock_guard<std::mutex> guard(SearchMutex);
-					Solves.push_back(Alg); // Thread safe code
+					if (Sink) // Streaming solves
+					{
+						if (!Sink(W.Thread, Path, Deep, Group, CubeAlg)) Interrupted.store(true, std::memory_order_relaxed);
+					}
+					else
+					{
+						SearchSolve S;
+						S.Order = Path.GetBranches(Deep);
+						S.Solve = Path.GetAlgorithm();
+						S.CubeSolve = CubeAlg;
+						W.Solves.push_back(std::move(S)); // Worker own buffer, no lock needed
+					}
 				}
 				iMask <<= 1; // Next group
+				Group++;
 			}
 		}
 
         if (++Deep == MaxSearchDeep) return; // It's no necessary to continue the search
 
         // Prepare the branches for the next level of the search
-		Steps LastStep, AuxStep;
+		Steps AuxStep;
 		switch (LevelsActions[Deep])
 		{
         case SearchActions::STEPS_LIST: // Use a steps (movements) list to create new branches
-			LastStep = Alg.Last();
-			for (auto S : LevelsSteps[Deep])
+			// Only the canonical branches are in the list: as in an algorithm "... U D ..." branch is the same than "... D U ..." branch,
+			// compute only one, and continue the search only on a longer algorithm (shorter or equal lenght means that will be calculated upper in the tree)
+			if (SearchStats::ENABLED) W.Levels[Deep].Pruned += LevelsSteps[Deep].size() - LevelsChildren[Deep][Path.GetState()].size();
+			for (const auto& Child : LevelsChildren[Deep][Path.GetState()])
 			{
-				// As in an algorithm "... U D ..." branch is the same than "... D U ..." branch, compute only one.
-				if (Algorithm::OppositeSteps(LastStep, S) && LastStep > S) continue;
+				Path.SetBranch(Deep, Child.Branch);
 				
                 // If NONE step are expressed specifically, go to the next level with the same algorithm
-                if (S == Steps::NONE) RunSearch(Alg, Deep, GroupMask);
-                else // Continue the search only on a longer algorithm (shorter or equal lenght means that will be calculated upper in the tree)
+                if (Child.Step == Steps::NONE) RunSearch(Path, CubeAlg, Deep, GroupMask, W);
+                else
 				{
-					Algorithm Alg2 = Alg;
-					if (!Alg2.AppendShrink(S)) RunSearch(Alg2, Deep, GroupMask); // Recursive
+					Path.Push(Child.Step, Child.State);
+					Cube CubeNext = CubeAlg;
+					CubeNext.ApplyStep(Child.Step); // Only the new step must be applied to the cube
+					if (!SplitBranch(W, Path, CubeNext, Deep, GroupMask)) RunSearch(Path, CubeNext, Deep, GroupMask, W); // Recursive
+					Path.Pop();
 				}
 			}
 			break;
 
         case SearchActions::OPPOSITE_STEP_2_PREVIOUS: // Use a opposite step of two levels before to continue the branch
-			LastStep = Alg.Last();
-			AuxStep = Alg.PenultimateInverted();
+			AuxStep = Path.PenultimateInverted();
+			Path.SetBranch(Deep, 0u);
 
-			// As in an algorithm "... U D ..." branch is the same than "... D U ..." branch, compute only one.
-			if (!(Algorithm::OppositeSteps(LastStep, AuxStep) && LastStep > AuxStep))
+			// Go deeper only on a canonical and longer algorithm (as in the steps list levels)
+			if (Path.Push(AuxStep))
 			{
-				Algorithm Alg2 = Alg;
-				// Go deeper only on a longer algorithm (shorter or equal lenght means that will be calculated upper in the tree)
-				if (!Alg2.AppendShrink(AuxStep)) RunSearch(Alg2, Deep, GroupMask); // Recursive
+				Cube CubeNext = CubeAlg;
+				CubeNext.ApplyStep(AuxStep);
+				RunSearch(Path, CubeNext, Deep, GroupMask, W); // Recursive
+				Path.Pop();
 			}
+			else if (SearchStats::ENABLED) W.Levels[Deep].Pruned++;
 			break;
 
 		default: break;
 		}
     }
 
+	// Add the counters of other search (levels and threads counters are added by index)
+	void SearchStats::Add(const SearchStats& S)
+	{
+		if (Levels.size() < S.Levels.size()) Levels.resize(S.Levels.size());
+		for (size_t level = 0u; level < S.Levels.size(); level++)
+		{
+			Levels[level].Nodes += S.Levels[level].Nodes;
+			Levels[level].Checks += S.Levels[level].Checks;
+			Levels[level].Pruned += S.Levels[level].Pruned;
+			Levels[level].Transpositions += S.Levels[level].Transpositions;
+			Levels[level].Solves += S.Levels[level].Solves;
+		}
+		if (ThreadsNodes.size() < S.ThreadsNodes.size()) ThreadsNodes.resize(S.ThreadsNodes.size(), 0ull);
+		for (size_t t = 0u; t < S.ThreadsNodes.size(); t++) ThreadsNodes[t] += S.ThreadsNodes[t];
+		if (ThreadsBusyTime.size() < S.ThreadsBusyTime.size()) ThreadsBusyTime.resize(S.ThreadsBusyTime.size(), 0.0);
+		for (size_t t = 0u; t < S.ThreadsBusyTime.size(); t++) ThreadsBusyTime[t] += S.ThreadsBusyTime[t];
+		Time += S.Time;
+	}
+
     // Returns best solve algorithm from the Solves vector class member and his score for the given start layer
     // F2L pieces are used as evaluation condition
 	uint DeepSearch::EvaluateF2LResult(Algorithm& BestSolve, Layers StartLayer, SearchPolicies Policy) 
 	{
 		if (Solves.size() <= 0) return 0u; // No solves
 
-		// Pieces to search
-		PiecesGroups F2L_1, F2L_2, F2L_3, F2L_4, CrossPG;
-
-        // Get the required cross and F2L pieces groups based on the start layer
-		switch (StartLayer)
-		{
-		case Layers::U:
-			CrossPG = PiecesGroups::C_U;
-			F2L_1 = PiecesGroups::F2L_U_UFR;
-			F2L_2 = PiecesGroups::F2L_U_UFL;
-			F2L_3 = PiecesGroups::F2L_U_UBR;
-			F2L_4 = PiecesGroups::F2L_U_UBL;
-			break;
-		case Layers::D:
-			CrossPG = PiecesGroups::C_D;
-			F2L_1 = PiecesGroups::F2L_D_DFR;
-			F2L_2 = PiecesGroups::F2L_D_DFL;
-			F2L_3 = PiecesGroups::F2L_D_DBR;
-			F2L_4 = PiecesGroups::F2L_D_DBL;
-			break;
-		case Layers::F:
-			CrossPG = PiecesGroups::C_F;
-			F2L_1 = PiecesGroups::F2L_F_UFR;
-			F2L_2 = PiecesGroups::F2L_F_UFL;
-			F2L_3 = PiecesGroups::F2L_F_DFR;
-			F2L_4 = PiecesGroups::F2L_F_DFL;
-			break;
-		case Layers::B:
-			CrossPG = PiecesGroups::C_B;
-			F2L_1 = PiecesGroups::F2L_B_UBR;
-			F2L_2 = PiecesGroups::F2L_B_UBL;
-			F2L_3 = PiecesGroups::F2L_B_DBR;
-			F2L_4 = PiecesGroups::F2L_B_DBL;
-			break;
-		case Layers::R:
-			CrossPG = PiecesGroups::C_R;
-			F2L_1 = PiecesGroups::F2L_R_UFR;
-			F2L_2 = PiecesGroups::F2L_R_UBR;
-			F2L_3 = PiecesGroups::F2L_R_DFR;
-			F2L_4 = PiecesGroups::F2L_R_DBR;
-			break;
-		case Layers::L:
-			CrossPG = PiecesGroups::C_L;
-			F2L_1 = PiecesGroups::F2L_L_UFL;
-			F2L_2 = PiecesGroups::F2L_L_UBL;
-			F2L_3 = PiecesGroups::F2L_L_DFL;
-			F2L_4 = PiecesGroups::F2L_L_DBL;
-			break;
-		default: return 0u; // Invalid cross layer
-		}
+		// Get the required cross and F2L pieces groups based on the start layer
+		PiecesGroups CrossPG, F2L_Groups[4];
+		if (!GetF2LPiecesGroups(StartLayer, CrossPG, F2L_Groups)) return 0u; // Invalid cross layer
+		const PiecesGroups F2L_1 = F2L_Groups[0], F2L_2 = F2L_Groups[1], F2L_3 = F2L_Groups[2], F2L_4 = F2L_Groups[3];
 
         // Based on the search policy, different conditions have different weights in the final score
-        uint SolveSizeMagnitude, SolveF2LMagnitude, SolveOppositeLayerMagnitude, SolveOrientedMagnitude, SolveNotAdjacentMagnitude;
-		switch (Policy)
+		const F2LScoreWeights Weights(Policy);
+		const uint SolveSizeMagnitude = Weights.Size, SolveF2LMagnitude = Weights.F2L, SolveOppositeLayerMagnitude = Weights.OppositeLayer,
+				   SolveOrientedMagnitude = Weights.Oriented, SolveNotAdjacentMagnitude = Weights.NotAdjacent;
+
+		// Cubes status after each solve (stored in the search if available)
+		std::vector<Cube> AppliedCubes;
+		if (SolvesCubes.size() != Solves.size())
 		{
-		case SearchPolicies::SHORT:
-			SolveSizeMagnitude = 1000u;
-			SolveF2LMagnitude = 100u;
-			SolveOppositeLayerMagnitude = 10u;
-            SolveOrientedMagnitude = 50u;
-            SolveNotAdjacentMagnitude = 10u;
-			break;
-		case SearchPolicies::BEST_SOLVES:
-		default: 
-			SolveSizeMagnitude = 1u;
-			SolveF2LMagnitude = 1000u;
-			SolveOppositeLayerMagnitude = 10u;
-            SolveOrientedMagnitude = 50u;
-            SolveNotAdjacentMagnitude = 10u;
-			break;
+			for (auto& s : Solves)
+			{
+				Cube C = CubeBase;
+				C.ApplyAlgorithm(s);
+				AppliedCubes.push_back(C);
+			}
 		}
+		const std::vector<Cube>& SCubes = AppliedCubes.empty() ? SolvesCubes : AppliedCubes;
+
+		// Check the cross and F2L groups in all solves at once
+		CubeBatch Batch(static_cast<uint>(SCubes.size()));
+		for (uint n = 0u; n < SCubes.size(); n++) Batch.Set(n, SCubes[n]);
+
+		std::vector<bool> CrossSolved, F2L1Solved, F2L2Solved, F2L3Solved, F2L4Solved;
+		S64 EMask, CMask;
+		Cube::GetMasksSolved(CrossPG, EMask, CMask);
+		if (Batch.IsSolved(EMask, CMask, CrossSolved) == 0u) { BestSolve = Solves[0]; return 0u; } // No solve with the cross
+		Cube::GetMasksSolved(F2L_1, EMask, CMask);
+		Batch.IsSolved(EMask, CMask, F2L1Solved);
+		Cube::GetMasksSolved(F2L_2, EMask, CMask);
+		Batch.IsSolved(EMask, CMask, F2L2Solved);
+		Cube::GetMasksSolved(F2L_3, EMask, CMask);
+		Batch.IsSolved(EMask, CMask, F2L3Solved);
+		Cube::GetMasksSolved(F2L_4, EMask, CMask);
+		Batch.IsSolved(EMask, CMask, F2L4Solved);
 
 		uint Score, MaxScore = 0u, MaxScoreIndex = 0u, Index = 0u;
 
         for (auto& s : Solves) // Check each solve to get the best one
 		{
-			Score = (s.GetSize() > 50u ? 0u : 50u - s.GetSize()) * SolveSizeMagnitude;
-			Cube CheckCube = CubeBase;
-			CheckCube.ApplyAlgorithm(s);
+			if (!CrossSolved[Index]) { Index++; continue; }
 
-			if (!CheckCube.IsSolved(CrossPG)) {	Index++; continue; }
+			Score = (s.GetSize() > 50u ? 0u : 50u - s.GetSize()) * SolveSizeMagnitude;
+			const Cube& CheckCube = SCubes[Index];
 
 			// Check F2L solves
-			if (CheckCube.IsSolved(F2L_1)) Score += SolveF2LMagnitude;
-			if (CheckCube.IsSolved(F2L_2)) Score += SolveF2LMagnitude;
-			if (CheckCube.IsSolved(F2L_3)) Score += SolveF2LMagnitude;
-			if (CheckCube.IsSolved(F2L_4)) Score += SolveF2LMagnitude;
+			if (F2L1Solved[Index]) Score += SolveF2LMagnitude;
+			if (F2L2Solved[Index]) Score += SolveF2LMagnitude;
+			if (F2L3Solved[Index]) Score += SolveF2LMagnitude;
+			if (F2L4Solved[Index]) Score += SolveF2LMagnitude;
 
             // Check both F2L pieces conditionvin the opposite layer
 			Layers EndLayer = Cube::OppositeLayer(StartLayer);
@@ -377,4 +711,286 @@ namespace grcube3
 
 		return MaxScore;
 	}
+
+	// Get the cross and F2L pieces groups for the given cross layer (false if the layer is not valid)
+	bool DeepSearch::GetF2LPiecesGroups(const Layers CrossLayer, PiecesGroups& Cross, PiecesGroups F2L[4])
+	{
+		switch (CrossLayer)
+		{
+		case Layers::U:
+			Cross = PiecesGroups::C_U;
+			F2L[0] = PiecesGroups::F2L_U_UFR;
+			F2L[1] = PiecesGroups::F2L_U_UFL;
+			F2L[2] = PiecesGroups::F2L_U_UBR;
+			F2L[3] = PiecesGroups::F2L_U_UBL;
+			break;
+		case Layers::D:
+			Cross = PiecesGroups::C_D;
+			F2L[0] = PiecesGroups::F2L_D_DFR;
+			F2L[1] = PiecesGroups::F2L_D_DFL;
+			F2L[2] = PiecesGroups::F2L_D_DBR;
+			F2L[3] = PiecesGroups::F2L_D_DBL;
+			break;
+		case Layers::F:
+			Cross = PiecesGroups::C_F;
+			F2L[0] = PiecesGroups::F2L_F_UFR;
+			F2L[1] = PiecesGroups::F2L_F_UFL;
+			F2L[2] = PiecesGroups::F2L_F_DFR;
+			F2L[3] = PiecesGroups::F2L_F_DFL;
+			break;
+		case Layers::B:
+			Cross = PiecesGroups::C_B;
+			F2L[0] = PiecesGroups::F2L_B_UBR;
+			F2L[1] = PiecesGroups::F2L_B_UBL;
+			F2L[2] = PiecesGroups::F2L_B_DBR;
+			F2L[3] = PiecesGroups::F2L_B_DBL;
+			break;
+		case Layers::R:
+			Cross = PiecesGroups::C_R;
+			F2L[0] = PiecesGroups::F2L_R_UFR;
+			F2L[1] = PiecesGroups::F2L_R_UBR;
+			F2L[2] = PiecesGroups::F2L_R_DFR;
+			F2L[3] = PiecesGroups::F2L_R_DBR;
+			break;
+		case Layers::L:
+			Cross = PiecesGroups::C_L;
+			F2L[0] = PiecesGroups::F2L_L_UFL;
+			F2L[1] = PiecesGroups::F2L_L_UBL;
+			F2L[2] = PiecesGroups::F2L_L_DFL;
+			F2L[3] = PiecesGroups::F2L_L_DBL;
+			break;
+		default: return false; // Invalid cross layer
+		}
+		return true;
+	}
+
+	// Weights of each condition in the F2L score based on the search policy
+	F2LScoreWeights::F2LScoreWeights(const SearchPolicies Policy)
+	{
+		switch (Policy)
+		{
+		case SearchPolicies::SHORT:
+			Size = 1000u;
+			F2L = 100u;
+			OppositeLayer = 10u;
+			Oriented = 50u;
+			NotAdjacent = 10u;
+			break;
+		case SearchPolicies::BEST_SOLVES:
+		default:
+			Size = 1u;
+			F2L = 1000u;
+			OppositeLayer = 10u;
+			Oriented = 50u;
+			NotAdjacent = 10u;
+			break;
+		}
+	}
+
+	// Transposition table using up to the given megabytes (at least one entry)
+	TranspositionTable::TranspositionTable(const uint MegaBytes)
+	{
+		const S64 MaxEntries = (static_cast<S64>(MegaBytes) << 20) / ENTRY_BYTES;
+		S64 Size = 1ull;
+		while ((Size << 1) <= MaxEntries) Size <<= 1;
+		Mask = Size - 1ull;
+		Entries.reset(new Entry[Size]);
+		Clear();
+	}
+
+	// Remove all entries
+	void TranspositionTable::Clear()
+	{
+		for (S64 n = 0ull; n <= Mask; n++)
+		{
+			Entries[n].Edges.store(0ull, std::memory_order_relaxed);
+			Entries[n].Corners.store(0ull, std::memory_order_relaxed);
+			Entries[n].Data.store(0ull, std::memory_order_relaxed);
+			Entries[n].Check.store(0ull, std::memory_order_relaxed);
+		}
+	}
+
+	// Returns true if the cube state has been searched with the same pieces groups and the same or more remaining levels
+	bool TranspositionTable::Visit(const Cube& C, const M16 GroupMask, const uint Remaining)
+	{
+		const S64 Edges = C.GetEdgesStatus(), Corners = C.GetCornersStatus();
+		Entry& E = Entries[(C.GetHash() ^ (static_cast<S64>(GroupMask) * 0x9E3779B97F4A7C15ull)) & Mask];
+
+		const S64 eEdges = E.Edges.load(std::memory_order_relaxed), eCorners = E.Corners.load(std::memory_order_relaxed);
+		const S64 eData = E.Data.load(std::memory_order_relaxed), eCheck = E.Check.load(std::memory_order_relaxed);
+
+		if (eCheck == (eEdges ^ eCorners ^ eData ^ CHECK_SEED) && eEdges == Edges && eCorners == Corners &&
+			(eData & 0xFFFFull) == GroupMask && (eData >> 16) >= Remaining) return true;
+
+		const S64 Data = static_cast<S64>(GroupMask) | (static_cast<S64>(Remaining) << 16);
+		E.Edges.store(Edges, std::memory_order_relaxed);
+		E.Corners.store(Corners, std::memory_order_relaxed);
+		E.Data.store(Data, std::memory_order_relaxed);
+		E.Check.store(Edges ^ Corners ^ Data ^ CHECK_SEED, std::memory_order_relaxed);
+		return false;
+	}
+
+	// Scorer for the given cross layers, search policy and search threads, keeping the K best solves for each layer
+	F2LScorer::F2LScorer(const std::vector<Layers>& CrossLayers, const SearchPolicies Policy, const uint Threads, const uint KBest) : Weights(Policy)
+	{
+		for (const auto L : CrossLayers)
+		{
+			LayerData LD;
+			PiecesGroups CrossPG;
+			if (!DeepSearch::GetF2LPiecesGroups(L, CrossPG, LD.F2L)) continue;
+			LD.Layer = L;
+			LD.EndLayer = Cube::OppositeLayer(L);
+			Cube::GetMasksSolved(CrossPG, LD.CrossE, LD.CrossC);
+			for (uint n = 0u; n < 4u; n++) Cube::GetMasksSolved(LD.F2L[n], LD.F2LE[n], LD.F2LC[n]);
+			LayersData.push_back(LD);
+		}
+		ByGroup = false;
+		K = KBest > 0u ? KBest : 1u;
+		Init(Threads);
+	}
+
+	// Scorer for the given number of pieces groups in a multiple search with the same cross layer
+	F2LScorer::F2LScorer(const Layers CrossLayer, const uint Groups, const SearchPolicies Policy, const uint Threads, const uint KBest) :
+		F2LScorer(std::vector<Layers>(Groups, CrossLayer), Policy, Threads, KBest)
+	{
+		ByGroup = true;
+	}
+
+	// Initialize the heaps and bounds for the given threads
+	void F2LScorer::Init(const uint Threads)
+	{
+		Heaps.resize(Threads > 0u ? Threads : 1u, std::vector<std::vector<ScoredSolve>>(LayersData.size()));
+		Bounds.reset(new std::atomic<uint>[LayersData.size()]);
+		for (uint l = 0u; l < LayersData.size(); l++) Bounds[l] = 0u;
+		LengthLimit = SearchPath::MAX_STEPS;
+	}
+
+	// Send the search solves to this scorer and limit the search length with the best scores
+	void F2LScorer::Attach(DeepSearch& DS)
+	{
+		DS.SetSolveSink([this](const uint Thread, const SearchPath& Path, const uint Level, const uint Group, const Cube& C) { return Add(Thread, Path, Level, Group, C); });
+		DS.SetLengthLimit(&LengthLimit);
+	}
+
+	// Score a solve in each layer with the cross solved (or for the solved pieces group), and keep it if it's one of the K best
+	// solves in the thread
+	bool F2LScorer::Add(const uint Thread, const SearchPath& Path, const uint Level, const uint Group, const Cube& C)
+	{
+		const uint Length = Path.GetSize();
+		for (uint l = 0u; l < LayersData.size(); l++)
+		{
+			if (ByGroup && l != Group) continue; // Solve for other pieces group
+
+			const uint Score = GetLayerScore(LayersData[l], C, Length);
+			if (Score == 0u) continue; // No cross
+
+			std::vector<ScoredSolve>& Heap = Heaps[Thread][l];
+			if (Heap.size() >= K && Score < Heap.front().Score) continue; // Not in the K best solves
+
+			ScoredSolve S;
+			S.Score = Score;
+			S.Order = Path.GetBranches(Level);
+			if (Heap.size() >= K)
+			{
+				if (!IsBetter(S, Heap.front())) continue;
+				std::pop_heap(Heap.begin(), Heap.end(), IsBetter);
+				Heap.pop_back();
+			}
+			S.Solve = Path.GetAlgorithm();
+			Heap.push_back(std::move(S));
+			std::push_heap(Heap.begin(), Heap.end(), IsBetter);
+
+			if (Heap.size() >= K) UpdateBound(l, Heap.front().Score);
+		}
+		return true;
+	}
+
+	// Score of a solve with the given length and cube state for a layer (0 if the cross is not solved)
+	uint F2LScorer::GetLayerScore(const LayerData& LD, const Cube& C, const uint Length) const
+	{
+		if (!C.IsSolved(LD.CrossE, LD.CrossC)) return 0u;
+
+		uint Score = (Length > 50u ? 0u : 50u - Length) * Weights.Size;
+		for (uint n = 0u; n < 4u; n++)
+		{
+			if (C.IsSolved(LD.F2LE[n], LD.F2LC[n])) Score += Weights.F2L;
+			if (C.IsF2LOriented(LD.F2L[n])) Score += Weights.Oriented;
+			else if (C.ArePiecesInLayer(LD.F2L[n], LD.EndLayer))
+			{
+				Score += Weights.OppositeLayer;
+				if (C.IsF2LAdjacent(LD.F2L[n])) Score += Weights.NotAdjacent;
+			}
+		}
+		return Score;
+	}
+
+	// Get the score of a solve for the pieces group (0 if the group is not scored or the cross is not solved)
+	uint F2LScorer::GetGroupScore(const uint Group, const Cube& C, const uint Length) const
+	{
+		return ByGroup && Group < LayersData.size() ? GetLayerScore(LayersData[Group], C, Length) : 0u;
+	}
+
+	// Set a score already reached by K solves of the pieces group
+	void F2LScorer::SetGroupMinScore(const uint Group, const uint Score)
+	{
+		if (ByGroup && Group < LayersData.size()) UpdateBound(Group, Score);
+	}
+
+	// Update the layer bound with a new K-th score and the search length limit
+	// A solve with a path longer than the limit can't reach the K-th score in any layer, even with all the F2L conditions
+	void F2LScorer::UpdateBound(const uint LayerIndex, const uint Score)
+	{
+		uint Bound = Bounds[LayerIndex].load(std::memory_order_relaxed);
+		while (Score > Bound && !Bounds[LayerIndex].compare_exchange_weak(Bound, Score, std::memory_order_relaxed));
+
+		uint Limit = 0u;
+		const uint MaxBonus = Weights.GetMaxBonus();
+		for (uint l = 0u; l < LayersData.size(); l++)
+		{
+			const uint B = Bounds[l].load(std::memory_order_relaxed);
+			if (B <= MaxBonus) return; // Any length can reach the bound for this layer
+			const uint SizeSteps = (B - MaxBonus + Weights.Size - 1u) / Weights.Size; // Minimum size score steps to reach the bound
+			const uint LayerLimit = SizeSteps >= 50u ? 0u : 50u - SizeSteps;
+			if (LayerLimit > Limit) Limit = LayerLimit;
+		}
+
+		uint Current = LengthLimit.load(std::memory_order_relaxed);
+		while (Limit < Current && !LengthLimit.compare_exchange_weak(Current, Limit, std::memory_order_relaxed));
+	}
+
+	// Get the K best solves for the layer from all threads, from best to worst
+	std::vector<F2LScorer::ScoredSolve> F2LScorer::GetTop(const Layers L) const
+	{
+		for (uint l = 0u; l < LayersData.size(); l++) if (LayersData[l].Layer == L) return GetIndexTop(l);
+		return std::vector<ScoredSolve>();
+	}
+
+	// Get the K best solves for the layer data index from all threads, from best to worst
+	std::vector<F2LScorer::ScoredSolve> F2LScorer::GetIndexTop(const uint Index) const
+	{
+		std::vector<ScoredSolve> Top;
+		for (const auto& ThreadHeaps : Heaps) Top.insert(Top.end(), ThreadHeaps[Index].begin(), ThreadHeaps[Index].end());
+		std::sort(Top.begin(), Top.end(), IsBetter);
+		if (Top.size() > K) Top.resize(K);
+		return Top;
+	}
+
+	// Get the best solve for the layer and his score (0 and the algorithm is not changed if there are no solves)
+	uint F2LScorer::GetBest(const Layers L, Algorithm& BestSolve) const
+	{
+		const std::vector<ScoredSolve> Top = GetTop(L);
+		if (Top.empty()) return 0u;
+		BestSolve = Top[0].Solve;
+		return Top[0].Score;
+	}
+
+	// Get the best solve for the pieces group and his score (0 and the algorithm is not changed if there are no solves)
+	uint F2LScorer::GetGroupBest(const uint Group, Algorithm& BestSolve) const
+	{
+		if (!ByGroup || Group >= LayersData.size()) return 0u;
+		const std::vector<ScoredSolve> Top = GetIndexTop(Group);
+		if (Top.empty()) return 0u;
+		BestSolve = Top[0].Solve;
+		return Top[0].Score;
+	}
 }
@@ -23,12 +23,20 @@
 #pragma once
 
 #include <vector>
+#include <array>
+#include <deque>
+#include <memory>
+#include <atomic>
 #include <mutex>
+#include <condition_variable>
 #include <thread>
+#include <chrono>
+#include <functional>
 
 #include "cube_definitions.h"
 #include "algorithm.h"
 #include "cube.h"
+#include "pruning.h"
 
 namespace grcube3
 {
@@ -54,6 +62,203 @@ namespace grcube3
 		MasksPair(const S64 EMask = 0ull, const S64 CMask = 0ull) { MaskE = EMask; MaskC = CMask; }
 	};
 
+    // Automaton of the canonical sequences of single layer steps, to create the search branches with a table lookup
+	// Each state stands for the last two steps of a path, and the transitions follow the rules to discard redundant branches:
+	// "... U D ..." is the same branch than "... D U ..." (only one order is allowed) and steps that shrink with the previous steps are not added
+	class CanonicalSteps
+	{
+	public:
+		static constexpr uint STEPS = static_cast<uint>(Steps::L2) + 1u; // Steps in the automaton (from Steps::NONE to Steps::L2)
+		static constexpr uint REJECT = 0xFFu; // Transition for a step not allowed
+
+		static const CanonicalSteps& Get(); // Automaton shared by all searches (built the first time is requested)
+
+		uint GetStart() const { return Start; } // State for an empty path
+		uint GetStates() const { return static_cast<uint>(Next.size()); } // Number of states
+
+		// Next state after appending the given step (REJECT if the step is not allowed)
+		uint GetNext(const uint State, const Steps S) const { return Next[State][static_cast<uint>(S)]; }
+		// Next state after appending the given step, allowed or not (for paths not created by the search)
+		uint GetNextAny(const uint State, const Steps S) const { return NextAny[State][static_cast<uint>(S)]; }
+
+	private:
+		CanonicalSteps(); // Build the automaton from the Algorithm rules, merging the equivalent states
+
+		uint Start; // Start state
+		std::vector<std::array<unsigned char, STEPS>> Next, NextAny; // Transitions tables
+	};
+
+    // Fixed-capacity steps stack to store the current search path (no heap allocations while searching)
+	// The branch index taken in each search level is also stored, to sort the solves as found in a single thread search
+	class SearchPath
+	{
+	public:
+		static constexpr uint MAX_STEPS = 64u; // Maximum path length (and maximum search levels)
+
+		SearchPath() { Size = 0u; States[0] = static_cast<unsigned char>(CanonicalSteps::Get().GetStart()); } // Empty path constructor
+		SearchPath(Algorithm& Alg) // Path from algorithm constructor
+		{
+			const CanonicalSteps& CS = CanonicalSteps::Get();
+			Size = 0u;
+			States[0] = static_cast<unsigned char>(CS.GetStart());
+			for (uint n = 0u; n < Alg.GetSize() && n < MAX_STEPS; n++)
+			{
+				Path[Size] = Alg[n];
+				States[Size + 1u] = static_cast<unsigned char>(Alg[n] < static_cast<Steps>(CanonicalSteps::STEPS) ? CS.GetNextAny(States[Size], Alg[n]) : CS.GetStart());
+				Size++;
+			}
+		}
+
+		uint GetSize() const { return Size; } // Get the path length
+		Steps Last() const { return Size > 0u ? Path[Size - 1u] : Steps::NONE; } // Get the path last step
+		Steps Penultimate() const { return Size > 1u ? Path[Size - 2u] : Steps::NONE; } // Get the path penultimate step
+		Steps PenultimateInverted() const { return Algorithm::GetInvertedStep(Penultimate()); } // Get the inverted penultimate step
+
+		uint GetState() const { return States[Size]; } // Get the canonical steps automaton state for the path
+
+		// Append the step at the end of the path only if the path remains canonical
+		bool Push(const Steps S)
+		{
+			if (Size >= MAX_STEPS || S >= static_cast<Steps>(CanonicalSteps::STEPS)) return false;
+			const uint NextState = CanonicalSteps::Get().GetNext(States[Size], S);
+			if (NextState == CanonicalSteps::REJECT) return false;
+			Push(S, NextState);
+			return true;
+		}
+		void Push(const Steps S, const uint NextState) { Path[Size] = S; States[++Size] = static_cast<unsigned char>(NextState); } // Append an allowed step
+		void Pop() { Size--; } // Remove the last step
+
+		void SetBranch(const uint Level, const uint Index) { Branches[Level] = Index; } // Set the branch index for the given level
+		// Get the branch indexes from the first level to the given level
+		std::vector<uint> GetBranches(const uint Level) const { return std::vector<uint>(Branches, Branches + Level + 1u); }
+
+		// Get the path as an algorithm
+		Algorithm GetAlgorithm() const { Algorithm A; for (uint n = 0u; n < Size; n++) A.Append(Path[n]); return A; }
+
+	private:
+		Steps Path[MAX_STEPS]; // Path steps
+		uint Size; // Number of steps in the path
+		uint Branches[MAX_STEPS]; // Branch index in each level
+		unsigned char States[MAX_STEPS + 1u]; // Canonical steps automaton state for each path length
+	};
+
+    // Bounded table of the cube states already searched, entries are read and written without locks
+	// Each entry stores the cube state, the pieces groups still not solved and the remaining search levels
+	class TranspositionTable
+	{
+	public:
+		static constexpr uint ENTRY_BYTES = 32u; // Memory used by each entry
+
+		TranspositionTable(const uint); // Table using up to the given megabytes (at least one entry)
+
+		S64 GetSize() const { return Mask + 1ull; } // Number of entries
+		void Clear(); // Remove all entries
+
+		// Returns true if the cube state has been searched with the same pieces groups and the same or more remaining levels
+		// If not, the state is stored (replacing the previous entry in the same slot)
+		bool Visit(const Cube&, const M16, const uint);
+
+	private:
+		// Entry words are written and read without locks, the check word discards entries mixed by concurrent writes
+		struct Entry { std::atomic<S64> Edges, Corners, Data, Check; };
+
+		static constexpr S64 CHECK_SEED = 0x5BD1E9955BD1E995ull; // Empty entries (all zero) are never valid
+
+		std::unique_ptr<Entry[]> Entries; // Table entries
+		S64 Mask; // Entries - 1 (power of two entries)
+	};
+
+    // Search branch for a steps list level: branch index, step and automaton state after the step
+	struct SearchChild
+	{
+		uint Branch; // Branch index in the level steps list
+		Steps Step; // Step to append (Steps::NONE to continue with the same path)
+		uint State; // Canonical steps automaton state after the step
+	};
+
+    // Cancellation token to stop a running search from other thread (shared by all the searches that use it)
+	class SearchCancel
+	{
+	public:
+		void Cancel() { Cancelled.store(true, std::memory_order_relaxed); } // Request the searches to stop
+		void Reset() { Cancelled.store(false, std::memory_order_relaxed); } // Allow new searches
+		bool IsCancelled() const { return Cancelled.load(std::memory_order_relaxed); } // Check if the searches must stop
+	private:
+		std::atomic<bool> Cancelled{ false };
+	};
+
+    // Search work in a search level
+	struct LevelStats
+	{
+		S64 Nodes = 0ull; // Branches expanded
+		S64 Checks = 0ull; // Solve conditions evaluated
+		S64 Pruned = 0ull; // Branches skipped (pruning tables, solves length limit or not canonical steps)
+		S64 Transpositions = 0ull; // Branches skipped by the transposition table
+		S64 Solves = 0ull; // Solves found
+	};
+
+    // Statistics of a search
+	// The counters for each level are only avaliable if GRCUBE_SEARCH_STATS is defined (DEFINES += GRCUBE_SEARCH_STATS),
+	// otherwise they are compiled out and the levels vector is empty
+	struct SearchStats
+	{
+#if defined(GRCUBE_SEARCH_STATS)
+		static constexpr bool ENABLED = true;
+#else
+		static constexpr bool ENABLED = false;
+#endif
+		std::vector<LevelStats> Levels; // Counters for each search level (sum of all threads)
+		std::vector<S64> ThreadsNodes; // Branches expanded by each thread
+		std::vector<double> ThreadsBusyTime; // Time searching in each thread (seconds), to see the load imbalance
+		double Time = 0.0; // Search wall time (seconds)
+
+		void Add(const SearchStats&); // Add the counters of other search (i.e. the searches of a CFOP stage)
+	};
+
+    // Search task (a pending search branch, with the cube state for the branch path)
+	struct SearchTask
+	{
+		SearchPath Path; // Branch path
+		Cube CubeTask; // Cube with the scramble and the branch path applied
+		uint Deep; // Branch search level
+		M16 GroupMask; // Pieces groups still not solved in the branch
+	};
+
+    // Solve found in a search, with the branch indexes to sort it
+	struct SearchSolve
+	{
+		std::vector<uint> Order; // Branch indexes in the search tree
+		Algorithm Solve; // Solve algorithm
+		Cube CubeSolve; // Cube with the scramble and the solve algorithm applied
+	};
+
+    // Function called for each solve found, from the search thread that finds it (the solve is not stored in the search)
+	// Parameters: thread index, solve path, search level (the path branch indexes up to this level give the search tree order),
+	// solved pieces group index and cube with the scramble and the solve applied. Returns false to stop the search
+	typedef std::function<bool(const uint, const SearchPath&, const uint, const uint, const Cube&)> SolveSink;
+
+    // Search worker data (each search thread owns a tasks queue, other threads can steal tasks from it)
+	struct SearchWorker
+	{
+		uint Thread = 0u; // Thread index
+		std::mutex QueueMutex; // Mutex for the tasks queue
+		std::deque<SearchTask> Tasks; // Pending tasks (the owner takes from the back, thieves from the front)
+		std::vector<SearchSolve> Solves; // Solves found by this worker (only accessed by the owner thread)
+		S64 TableHits = 0ull, TableMisses = 0ull; // Transposition table probes by this worker
+		S64 Nodes = 0ull; // Search nodes visited by this worker
+		double BusyTime = 0.0; // Time running tasks (seconds)
+		std::vector<LevelStats> Levels; // Counters for each search level (only used if SearchStats::ENABLED)
+	};
+
+    // Weights of each condition in the F2L score of a solve, based on the search policy
+	struct F2LScoreWeights
+	{
+		uint Size, F2L, OppositeLayer, Oriented, NotAdjacent; // Score magnitudes for each condition
+		F2LScoreWeights(const SearchPolicies);
+		// Maximum score not based on the solve size (each F2L pair can be solved and oriented, or in the opposite layer and adjacent)
+		uint GetMaxBonus() const { return 4u * (F2L + (Oriented > OppositeLayer + NotAdjacent ? Oriented : OppositeLayer + NotAdjacent)); }
+	};
+
     // Class to do a search
 	class DeepSearch
 	{
@@ -67,18 +272,60 @@ namespace grcube3
         // What kind of search has to be done in each search level
         // If OptimizeThreads is true (and exist the conditions to optimize threads), the first search level never will be checked
         // If multiple search is enabled, each pieces group will be checked separatelly. If disabled, all pieces groups are evaluated together
-        DeepSearch(Algorithm&, std::vector<PiecesGroups>&, std::vector<SearchLevel>&, bool = false, bool = false);
+        DeepSearch(const Algorithm&, const std::vector<PiecesGroups>&, std::vector<SearchLevel>&, bool = false, bool = false);
+        // Search from the given cube state instead of a scramble (to continue a solve from the state already reached)
+        // Each solve group is a list of pieces groups evaluated together, and the solve groups are checked separately (as
+        // in a multiple search). The first level is not extended for threads optimization
+        DeepSearch(const Cube&, const std::vector<std::vector<PiecesGroups>>&, std::vector<SearchLevel>&);
 
 		uint GetCores() const { return Cores; } // Get system cores
 		uint GetCoresUsed() const { return UsedCores; } // Get system cores used in the last search
 		uint GetBranches() const { return RootBranches; } // Get number of root branches in the search
 		uint GetDeep() const { return MaxSearchDeep; } // Get the maximum deep in the search
+		S64 GetNodes() const { return Nodes; } // Get the number of search nodes visited in the last search
+		// Get the number of threads used by Run with the given threads parameter
+		uint GetThreadsNumber(const int UseThreads) const { return UseThreads < 0 ? 1u : static_cast<uint>((UseThreads == 0 || UseThreads >= Cores) ? Cores : UseThreads); }
+		const SearchStats& GetStats() const { return Stats; } // Get the statistics of the last search
 
         void Run(const int = 0); // Run the search; -1: use no threads, 0: use all threas avaliable, other: use specified number of threads
 
+		// Use pruning tables to skip the branches that can't solve any pieces group in the remaining levels
+		// Only avaliable if all pieces groups are crosses (four edges) and search levels use single layer movements
+		bool SetCrossPruning();
+
+		// Use a transposition table with the given memory budget (megabytes) to skip the cube states already searched (0 to disable)
+		// Only the search levels from the last change in the levels configuration are checked (the subtree depends only on the cube state)
+		// Off by default: as only the first path to each state is expanded, equivalent solves through other paths are not returned
+		// The table is only used in searches without threads (Run(-1)), where the first path is always the same, so the solves
+		// don't depend on the threads timing
+		bool SetTranspositionTable(const uint);
+
+		S64 GetTableHits() const { return TableHits; } // Subtrees skipped by the transposition table in the last search
+		S64 GetTableMisses() const { return TableMisses; } // Cube states stored in the transposition table in the last search
+
+		// Search limits: when the search is cancelled, the deadline is reached or the nodes budget is spent, the search
+		// stops and keeps the solves already found (the search is marked as interrupted)
+		void SetCancel(const SearchCancel* C) { Cancel = C; } // Cancellation token (nullptr for none)
+		void SetDeadline(const std::chrono::steady_clock::time_point& T) { Deadline = T; } // Time to stop the search
+		void SetTimeLimit(const double Seconds) // Time to stop the search from now (0 for no limit)
+		{
+			Deadline = Seconds > 0.0 ? std::chrono::steady_clock::now() + std::chrono::duration_cast<std::chrono::steady_clock::duration>(std::chrono::duration<double>(Seconds)) :
+									   std::chrono::steady_clock::time_point::max();
+		}
+		void SetNodesLimit(const S64 N) { NodesLimit = N; } // Approximate nodes budget (0 for no limit)
+		bool IsInterrupted() const { return Interrupted.load(std::memory_order_relaxed); } // Check if the last search was cut short
+		// Send the solves to the given function instead of storing them in the Solves vector (nullptr to store them)
+		// The function is called from the search threads without locks, so it should keep a state for each thread
+		// (thread index is lower than GetThreadsNumber) and the memory used doesn't depend on the number of solves
+		void SetSolveSink(const SolveSink& S) { Sink = S; }
+
         // Returns best F2L solve from the Solves vector class member and his score for the given start layer
         // F2L pieces are used as evaluation condition
 		uint EvaluateF2LResult(Algorithm&, Layers, SearchPolicies);
+		// Get the cross and F2L pieces groups for the given cross layer (false if the layer is not valid)
+		static bool GetF2LPiecesGroups(const Layers, PiecesGroups&, PiecesGroups[4]);
+		// Skip the branches with a path longer than the given limit, updated while searching (nullptr for no limit)
+		void SetLengthLimit(const std::atomic<uint>* L) { LengthLimit = L; }
 
 		// Get the real number of cores used (a search should be done )
 		int GetRealCores (int RequestedCores) const { return RequestedCores < 0 ? -1 : RequestedCores <= Cores ? RequestedCores : Cores; }
@@ -90,6 +337,7 @@ namespace grcube3
 		std::vector<SearchActions> LevelsActions; // Search actions in each level
 		std::vector<SearchCheck> LevelsCheck; // Search levels check list
 		std::vector<std::vector<Steps>> LevelsSteps; // Steps to search for each level
+		std::vector<std::vector<std::vector<SearchChild>>> LevelsChildren; // Allowed branches for each level and automaton state
         bool ExtendFirstLevel; // Use precalculated algorithms as first search level
         std::vector<Algorithm> FirstLevelAlgs; // Extended first level with two-steps algorithms for search
 
@@ -103,11 +351,61 @@ namespace grcube3
 
 		std::vector<MasksPair> SolveMasks; // Mask pairs for check solves
 
-		std::mutex SearchMutex; // Mutex for multithreading
+		std::vector<Cube> SolvesCubes; // Cube status for each solve (to evaluate the solves without applying them again)
+
+		std::vector<const CrossPruningTable*> PruningTables; // Pruning table for each mask pair (empty if pruning is not used)
+
+		static constexpr uint TRANSPOSITIONS_MIN_LEVELS = 3u; // Minimum remaining levels in a branch to check it in the transposition table
+		std::unique_ptr<TranspositionTable> Transpositions; // Cube states already searched (nullptr if not used)
+		uint TranspositionsLevel; // First level checked in the transposition table
+		bool UseTranspositions; // The transposition table is used in the current search (only without threads)
+		S64 TableHits, TableMisses; // Transposition table probes in the last search
+		S64 Nodes; // Search nodes visited in the last search
+		SearchStats Stats; // Statistics of the last search
+		SolveSink Sink; // Function to send the solves (empty to store them)
+		const std::atomic<uint>* LengthLimit; // Maximum path length for the solves (nullptr if not used)
+		// Search limits
+		static constexpr S64 LIMITS_CHECK_NODES = 1024ull; // Nodes searched by a thread between limits checks (power of two)
+		const SearchCancel* Cancel; // Cancellation token (nullptr if not used)
+		std::chrono::steady_clock::time_point Deadline; // Time to stop the search (max if not used)
+		S64 NodesLimit; // Nodes budget (0 if not used)
+		std::atomic<S64> LimitNodes; // Nodes counted for the budget in the current search
+		std::atomic<bool> Interrupted; // The search must stop (or has been stopped) before exhausting the search tree
+
+		// Work-stealing scheduler
+		static constexpr uint SPLIT_MIN_LEVELS = 3u; // Minimum remaining levels in a branch to send it to other threads
+		std::unique_ptr<SearchWorker[]> Workers; // Workers data (one per thread)
+		static constexpr uint IDLE_SPINS = 64u; // Tries to get a task (yielding the thread) before an idle thread waits
+		std::atomic<uint> PendingTasks; // Tasks queued or running
+		std::atomic<uint> QueuedTasks; // Tasks in the workers queues (not running yet)
+		std::atomic<uint> IdleWorkers; // Threads waiting for a task
+		std::mutex IdleMutex; // Mutex for the idle threads wait
+		std::condition_variable IdleCondition; // Notify idle threads a new queued task or the search end
 		
-		void RunThread(const uint); // Divide search branches into threads
+		void RunThread(const uint); // Run search tasks in a thread (own tasks first, then steal tasks from other threads)
+		bool PopTask(const uint, SearchTask&); // Get a task from the worker own queue
+		bool StealTask(const uint, SearchTask&); // Get a task from the queue of other worker
+		bool SplitBranch(SearchWorker&, const SearchPath&, const Cube&, const uint, const M16); // Send a branch to the worker queue if there are idle threads
+		void MergeSolves(); // Merge the workers solves in the search tree order
+		void NotifyIdle(const bool); // Wake up one idle thread (or all of them)
+		static MasksPair GetSolveMasks(const std::vector<PiecesGroups>&); // Solve masks pair for all the pieces in the pieces groups
+		// Check if the search has limits
+		bool IsLimited() const { return Cancel != nullptr || NodesLimit > 0ull || Deadline != std::chrono::steady_clock::time_point::max(); }
+		void CheckLimits(const S64); // Interrupt the search if any limit is reached (with the new nodes searched)
+
+		void RunSearch(SearchPath&, const Cube&, uint, M16, SearchWorker&); // Run a search branch (search path and cube state with the path applied)
 
-		void RunSearch(Algorithm&, uint, M16 = 1u); // Run a search branch
+		// Check with the pruning tables if any of the pieces groups can be solved with the given number of movements
+		bool IsInRange(const Cube& C, const uint Movs, const M16 GroupMask) const
+		{
+			M16 iMask = 1u;
+			for (const auto T : PruningTables)
+			{
+				if ((GroupMask & iMask) > 0u && T->GetDistance(C) <= Movs) return true;
+				iMask <<= 1;
+			}
+			return false;
+		}
 
         // Returns the initial mask for control which group of pieces are solved - for multiple search
 		M16 GetStartGroupMask() const
@@ -117,5 +415,71 @@ namespace grcube3
 			return GroupMask;
 		}
 	};
-}
 
+    // Scores the solves while searching with the same conditions as DeepSearch::EvaluateF2LResult, for one or more cross layers
+	// Each thread keeps only its K best solves for each layer, so the solves are not stored in the search. The K-th best score
+	// gives a search length limit: longer branches can't reach the score even with all the F2L conditions (branch and bound)
+	// In a multiple search, the solves of each pieces group can be scored separately (i.e. a group for each F2L slot)
+	class F2LScorer
+	{
+	public:
+		// Solve with its score and branch indexes in the search tree (to sort solves with the same score)
+		struct ScoredSolve
+		{
+			uint Score;
+			std::vector<uint> Order;
+			Algorithm Solve;
+		};
+
+		// Scorer for the given cross layers, search policy and search threads, keeping the K best solves for each layer
+		F2LScorer(const std::vector<Layers>&, const SearchPolicies, const uint, const uint = 1u);
+		// Scorer for the given number of pieces groups in a multiple search with the same cross layer, keeping the K best
+		// solves for each group (only the solves for the group are scored)
+		F2LScorer(const Layers, const uint, const SearchPolicies, const uint, const uint = 1u);
+
+		// Send the search solves to this scorer and limit the search length with the best scores
+		void Attach(DeepSearch&);
+
+		// Get the best solve for the layer and his score (0 and the algorithm is not changed if there are no solves)
+		uint GetBest(const Layers, Algorithm&) const;
+
+		// Get the K best solves for the layer, from best to worst
+		std::vector<ScoredSolve> GetTop(const Layers) const;
+
+		// Get the best solve for the pieces group and his score (0 and the algorithm is not changed if there are no solves)
+		uint GetGroupBest(const uint, Algorithm&) const;
+
+		// Get the score of a solve with the given length and cube state (scramble and solve applied) for the pieces group
+		uint GetGroupScore(const uint, const Cube&, const uint) const;
+
+		// Set a score already reached by K solves of the pieces group (i.e. solves known from other searches), so the longer
+		// branches are skipped from the start. The best solves are the same if the score is not over the best score of the search
+		void SetGroupMinScore(const uint, const uint);
+
+	private:
+		// Cross layer data
+		struct LayerData
+		{
+			Layers Layer, EndLayer; // Cross layer and opposite layer
+			S64 CrossE, CrossC; // Cross solve masks
+			PiecesGroups F2L[4]; // F2L pieces groups
+			S64 F2LE[4], F2LC[4]; // F2L solve masks
+		};
+
+		std::vector<LayerData> LayersData; // Data for each cross layer (or for each pieces group)
+		bool ByGroup; // Each layer data is for the solves of the pieces group with the same index
+		F2LScoreWeights Weights; // Score weights for the search policy
+		uint K; // Best solves to keep
+		std::vector<std::vector<std::vector<ScoredSolve>>> Heaps; // Best solves heap (worst first) for each thread and layer
+		std::unique_ptr<std::atomic<uint>[]> Bounds; // Best K-th score for each layer in any thread
+		std::atomic<uint> LengthLimit; // Maximum solve length that can improve the K-th score of a layer
+
+		bool Add(const uint, const SearchPath&, const uint, const uint, const Cube&); // Score a solve (solve sink)
+		void Init(const uint); // Initialize the heaps and bounds for the given threads
+		std::vector<ScoredSolve> GetIndexTop(const uint) const; // Get the K best solves for the layer data index
+		uint GetLayerScore(const LayerData&, const Cube&, const uint) const; // Score of a solve for a layer (0 if no cross)
+		void UpdateBound(const uint, const uint); // Update the layer bound and the length limit with a new K-th score
+		// Returns true if the first solve is better than the second one (higher score, or same score and first in the search tree)
+		static bool IsBetter(const ScoredSolve& S1, const ScoredSolve& S2) { return S1.Score != S2.Score ? S1.Score > S2.Score : S1.Order < S2.Order; }
+	};
+}
@@ -97,7 +97,75 @@ namespace grcube3
 		{Stickers::DB_B, Stickers::DB_D}, // DB
 		{Stickers::DR_R, Stickers::DR_D}, // DR
 	};
-			
+
+	// Array to get the source positions of the edges moved by each single layer step
+	const EdgePositions c_Edges::e_MovSrc[18][4] =
+	{
+		{ EdgePositions::UR, EdgePositions::UF, EdgePositions::UL, EdgePositions::UB }, // U
+		{ EdgePositions::UL, EdgePositions::UB, EdgePositions::UR, EdgePositions::UF }, // U'
+		{ EdgePositions::UB, EdgePositions::UR, EdgePositions::UF, EdgePositions::UL }, // U2
+		{ EdgePositions::DL, EdgePositions::DB, EdgePositions::DR, EdgePositions::DF }, // D
+		{ EdgePositions::DR, EdgePositions::DF, EdgePositions::DL, EdgePositions::DB }, // D'
+		{ EdgePositions::DB, EdgePositions::DR, EdgePositions::DF, EdgePositions::DL }, // D2
+		{ EdgePositions::UF, EdgePositions::DF, EdgePositions::FL, EdgePositions::FR }, // F
+		{ EdgePositions::DF, EdgePositions::UF, EdgePositions::FR, EdgePositions::FL }, // F'
+		{ EdgePositions::FL, EdgePositions::FR, EdgePositions::DF, EdgePositions::UF }, // F2
+		{ EdgePositions::UB, EdgePositions::DB, EdgePositions::BR, EdgePositions::BL }, // B
+		{ EdgePositions::DB, EdgePositions::UB, EdgePositions::BL, EdgePositions::BR }, // B'
+		{ EdgePositions::BR, EdgePositions::BL, EdgePositions::DB, EdgePositions::UB }, // B2
+		{ EdgePositions::DR, EdgePositions::UR, EdgePositions::FR, EdgePositions::BR }, // R
+		{ EdgePositions::UR, EdgePositions::DR, EdgePositions::BR, EdgePositions::FR }, // R'
+		{ EdgePositions::BR, EdgePositions::FR, EdgePositions::DR, EdgePositions::UR }, // R2
+		{ EdgePositions::UL, EdgePositions::DL, EdgePositions::BL, EdgePositions::FL }, // L
+		{ EdgePositions::DL, EdgePositions::UL, EdgePositions::FL, EdgePositions::BL }, // L'
+		{ EdgePositions::BL, EdgePositions::FL, EdgePositions::DL, EdgePositions::UL }  // L2
+	};
+
+	// Array to get the destination positions of the edges moved by each single layer step
+	const EdgePositions c_Edges::e_MovDst[18][4] =
+	{
+		{ EdgePositions::UF, EdgePositions::UL, EdgePositions::UB, EdgePositions::UR }, // U
+		{ EdgePositions::UF, EdgePositions::UL, EdgePositions::UB, EdgePositions::UR }, // U'
+		{ EdgePositions::UF, EdgePositions::UL, EdgePositions::UB, EdgePositions::UR }, // U2
+		{ EdgePositions::DF, EdgePositions::DL, EdgePositions::DB, EdgePositions::DR }, // D
+		{ EdgePositions::DF, EdgePositions::DL, EdgePositions::DB, EdgePositions::DR }, // D'
+		{ EdgePositions::DF, EdgePositions::DL, EdgePositions::DB, EdgePositions::DR }, // D2
+		{ EdgePositions::FR, EdgePositions::FL, EdgePositions::UF, EdgePositions::DF }, // F
+		{ EdgePositions::FR, EdgePositions::FL, EdgePositions::UF, EdgePositions::DF }, // F'
+		{ EdgePositions::FR, EdgePositions::FL, EdgePositions::UF, EdgePositions::DF }, // F2
+		{ EdgePositions::BL, EdgePositions::BR, EdgePositions::UB, EdgePositions::DB }, // B
+		{ EdgePositions::BL, EdgePositions::BR, EdgePositions::UB, EdgePositions::DB }, // B'
+		{ EdgePositions::BL, EdgePositions::BR, EdgePositions::UB, EdgePositions::DB }, // B2
+		{ EdgePositions::FR, EdgePositions::BR, EdgePositions::UR, EdgePositions::DR }, // R
+		{ EdgePositions::FR, EdgePositions::BR, EdgePositions::UR, EdgePositions::DR }, // R'
+		{ EdgePositions::FR, EdgePositions::BR, EdgePositions::UR, EdgePositions::DR }, // R2
+		{ EdgePositions::FL, EdgePositions::BL, EdgePositions::UL, EdgePositions::DL }, // L
+		{ EdgePositions::FL, EdgePositions::BL, EdgePositions::UL, EdgePositions::DL }, // L'
+		{ EdgePositions::FL, EdgePositions::BL, EdgePositions::UL, EdgePositions::DL }  // L2
+	};
+
+	// Array to get the mask of the edges not affected by each single layer step
+	const S64 c_Edges::e_MovKeep[18] =
+	{
+		EMASK_DATA & ~EMASK_U, EMASK_DATA & ~EMASK_U, EMASK_DATA & ~EMASK_U, // U, U', U2
+		EMASK_DATA & ~EMASK_D, EMASK_DATA & ~EMASK_D, EMASK_DATA & ~EMASK_D, // D, D', D2
+		EMASK_DATA & ~EMASK_F, EMASK_DATA & ~EMASK_F, EMASK_DATA & ~EMASK_F, // F, F', F2
+		EMASK_DATA & ~EMASK_B, EMASK_DATA & ~EMASK_B, EMASK_DATA & ~EMASK_B, // B, B', B2
+		EMASK_DATA & ~EMASK_R, EMASK_DATA & ~EMASK_R, EMASK_DATA & ~EMASK_R, // R, R', R2
+		EMASK_DATA & ~EMASK_L, EMASK_DATA & ~EMASK_L, EMASK_DATA & ~EMASK_L // L, L', L2
+	};
+
+	// Array to get the mask of the edges directions inverted by each single layer step (only F and B quarter turns)
+	const S64 c_Edges::e_MovFlip[18] =
+	{
+		0ull, 0ull, 0ull, // U, U', U2
+		0ull, 0ull, 0ull, // D, D', D2
+		EMASK_DIR_FR | EMASK_DIR_FL | EMASK_DIR_UF | EMASK_DIR_DF, EMASK_DIR_FR | EMASK_DIR_FL | EMASK_DIR_UF | EMASK_DIR_DF, 0ull, // F, F', F2
+		EMASK_DIR_BL | EMASK_DIR_BR | EMASK_DIR_UB | EMASK_DIR_DB, EMASK_DIR_BL | EMASK_DIR_BR | EMASK_DIR_UB | EMASK_DIR_DB, 0ull, // B, B', B2
+		0ull, 0ull, 0ull, // R, R', R2
+		0ull, 0ull, 0ull // L, L', L2
+	};
+
 	void c_Edges::e_U() // Movement U
 	{
 		S64 buffer = GetStatusPos_UF();
@@ -30,6 +30,7 @@ namespace grcube3
 {
 	class c_Edges
 	{
+		friend class CubeBatch; // Uses the movements tables
 	public:
 		c_Edges() { edges = EMASK_SOLVED; } // Constructor
 		~c_Edges() {} // Destructor
@@ -258,6 +259,11 @@ namespace grcube3
 		static constexpr auto s_DR_D = s_FR_F; // Array to get the sticker in the DR_D sticker position
 		static constexpr auto s_DR_R = s_FR_R; // Array to get the sticker in the DR_R sticker position	
 	
+		const static EdgePositions e_MovSrc[18][4]; // Array to get the source positions of the edges moved by each single layer step
+		const static EdgePositions e_MovDst[18][4]; // Array to get the destination positions of the edges moved by each single layer step
+		const static S64 e_MovKeep[18]; // Array to get the mask of the edges not affected by each single layer step
+		const static S64 e_MovFlip[18]; // Array to get the mask of the edges directions inverted by each single layer step
+
 		void e_Reset() { edges = EMASK_SOLVED; } // Reset edges status
 	
 		// Movements
@@ -267,6 +273,21 @@ namespace grcube3
 		void e_B();		void e_B2();	void e_Bp();
 		void e_R();		void e_R2();	void e_Rp();
 		void e_L();		void e_L2();	void e_Lp();
+
+		// Table-driven movement for single layer steps (from Steps::U to Steps::L2)
+		// Same result as the movement functions above (kept as reference), but without branches
+		void e_Move(const Steps S)
+		{
+			const uint m = static_cast<uint>(S) - static_cast<uint>(Steps::U);
+			S64 e = edges & e_MovKeep[m];
+			for (uint n = 0u; n < 4u; n++)
+			{
+				const uint src = static_cast<uint>(e_MovSrc[m][n]), dst = static_cast<uint>(e_MovDst[m][n]);
+				e |= ((edges >> (src << 2)) & 0xFull) << (dst << 2); // Position
+				e |= ((edges >> (src + 48u)) & 0x1ull) << (dst + 48u); // Direction
+			}
+			edges = e ^ e_MovFlip[m];
+		}
 	
 		// Change edges status bits (position only)
 		void PutStatusPos_FR(const S64 P) { edges = (edges & ~EMASK_POS_FR) | P; }
@@ -0,0 +1,355 @@
+/*  This file is part of "GR Cube"
+
+	Copyright (C) 2020 German Ramos Rodriguez
+
+	This program is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	This program is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+	German Ramos Rodriguez
+	Vigo, Spain
+	grvigo@hotmail.com
+*/
+
+#include <fstream>
+#include <cstdio>
+
+#include "pruning.h"
+
+namespace grcube3
+{
+	uint CrossPruningTable::EdgeMoves[24][18];
+	std::mutex CrossPruningTable::TablesMutex;
+	std::map<S64, std::unique_ptr<CrossPruningTable>> CrossPruningTable::Tables;
+
+	// Get the pruning table for the edges in the given mask (nullptr if the mask has not four edges)
+	const CrossPruningTable* CrossPruningTable::Get(const S64 EMask)
+	{
+		uint Positions[4], n = 0u;
+		for (uint p = 0u; p < 12u; p++)
+		{
+			if (((EMask >> (p << 2)) & 0xFull) == 0ull) continue;
+			if (n == 4u) return nullptr; // More than four edges
+			Positions[n++] = p;
+		}
+		if (n != 4u) return nullptr;
+
+		std::lock_guard<std::mutex> guard(TablesMutex);
+		auto& T = Tables[EMask];
+		if (!T)
+		{
+			if (Tables.size() == 1u) InitEdgeMoves(); // First table
+			T.reset(new CrossPruningTable(Positions));
+		}
+		return T.get();
+	}
+
+	// Fill the edge movements table (applying each movement to a solved cube)
+	void CrossPruningTable::InitEdgeMoves()
+	{
+		for (uint m = 0u; m < 18u; m++)
+		{
+			Cube C;
+			C.ApplyStep(static_cast<Steps>(m + static_cast<uint>(Steps::U)));
+			const S64 e = C.GetEdgesStatus();
+			for (uint p = 0u; p < 12u; p++)
+			{
+				const uint Piece = static_cast<uint>((e >> (p << 2)) & 0xFull), Dir = static_cast<uint>((e >> (p + 48u)) & 0x1ull);
+				// The edge in the 'Piece' position (solved cube) goes to 'p', a flipped edge keeps flipped
+				EdgeMoves[Piece * 2u][m] = p * 2u + Dir;
+				EdgeMoves[Piece * 2u + 1u][m] = p * 2u + (Dir ^ 1u);
+			}
+		}
+	}
+
+	// Build the table for the given edges positions with a breadth-first search from the solved state
+	CrossPruningTable::CrossPruningTable(const uint* EdgesPositions)
+	{
+		for (uint n = 0u; n < 16u; n++) Slots[n] = 4u;
+		for (uint n = 0u; n < 4u; n++) { Homes[n] = EdgesPositions[n]; Slots[Homes[n]] = n; }
+
+		Distances.assign(SIZE, 0xFF);
+		const uint SolvedDirs[4] = { 0u, 0u, 0u, 0u };
+		Distances[GetIndex(Homes, SolvedDirs)] = 0u;
+
+		uint Pos[4], Dir[4], NewPos[4], NewDir[4], Found = 1u;
+		for (uint d = 0u; Found < SIZE; d++)
+		{
+			for (uint i = 0u; i < SIZE; i++)
+			{
+				if (Distances[i] != d) continue;
+				GetState(i, Pos, Dir);
+				for (uint m = 0u; m < 18u; m++)
+				{
+					for (uint n = 0u; n < 4u; n++)
+					{
+						const uint s = EdgeMoves[Pos[n] * 2u + Dir[n]][m];
+						NewPos[n] = s >> 1;
+						NewDir[n] = s & 1u;
+					}
+					const uint Index = GetIndex(NewPos, NewDir);
+					if (Distances[Index] == 0xFF) { Distances[Index] = static_cast<unsigned char>(d + 1u); Found++; }
+				}
+			}
+		}
+	}
+
+	// Get the table index for the given edges status
+	uint CrossPruningTable::GetIndex(const S64 e) const
+	{
+		uint Pos[4], Dir[4];
+		for (uint p = 0u; p < 12u; p++)
+		{
+			const uint Slot = Slots[(e >> (p << 2)) & 0xFull];
+			if (Slot < 4u) { Pos[Slot] = p; Dir[Slot] = static_cast<uint>((e >> (p + 48u)) & 0x1ull); }
+		}
+		return GetIndex(Pos, Dir);
+	}
+
+	// Get the table index for the given positions and directions (positions ranked as a partial permutation)
+	uint CrossPruningTable::GetIndex(const uint* Pos, const uint* Dir)
+	{
+		const uint p1 = Pos[1] - (Pos[0] < Pos[1] ? 1u : 0u);
+		const uint p2 = Pos[2] - (Pos[0] < Pos[2] ? 1u : 0u) - (Pos[1] < Pos[2] ? 1u : 0u);
+		const uint p3 = Pos[3] - (Pos[0] < Pos[3] ? 1u : 0u) - (Pos[1] < Pos[3] ? 1u : 0u) - (Pos[2] < Pos[3] ? 1u : 0u);
+		return ((((Pos[0] * 11u + p1) * 10u + p2) * 9u + p3) << 4) | Dir[0] | (Dir[1] << 1) | (Dir[2] << 2) | (Dir[3] << 3);
+	}
+
+	// Get the positions and directions for the given table index
+	void CrossPruningTable::GetState(uint Index, uint* Pos, uint* Dir)
+	{
+		for (uint n = 0u; n < 4u; n++) Dir[n] = (Index >> n) & 1u;
+		Index >>= 4;
+
+		uint Ranks[4];
+		Ranks[3] = Index % 9u; Index /= 9u;
+		Ranks[2] = Index % 10u; Index /= 10u;
+		Ranks[1] = Index % 11u;
+		Ranks[0] = Index / 11u;
+
+		bool Used[12] = { false };
+		for (uint n = 0u; n < 4u; n++)
+		{
+			uint p = 0u;
+			for (uint r = Ranks[n]; Used[p] || r > 0u; p++) if (!Used[p]) r--;
+			Pos[n] = p;
+			Used[p] = true;
+		}
+	}
+
+	const uint XCrossPruningTable::EdgeSlots[16] = { 4u, 5u, 5u, 5u, 5u, 5u, 5u, 5u, 0u, 1u, 2u, 3u, 5u, 5u, 5u, 5u }; // DF, DL, DB, DR & FR
+	std::string XCrossPruningTable::File = "xcross_table.dat";
+	std::mutex XCrossPruningTable::TableMutex;
+	std::unique_ptr<XCrossPruningTable> XCrossPruningTable::Table;
+
+	// Get the table, loaded from the file (or built and saved if the file is not valid) the first time is requested
+	const XCrossPruningTable* XCrossPruningTable::Get()
+	{
+		std::lock_guard<std::mutex> guard(TableMutex);
+
+		if (!Table)
+		{
+			Table.reset(new XCrossPruningTable());
+			if (!Table->Load(File))
+			{
+				Table->Build();
+				Table->Save(File); // If the table can't be saved it will be built again in the next run
+			}
+		}
+		return Table.get();
+	}
+
+	// Load the table from the given file (a header with the file format version, the table size and the distances checksum,
+	// all of them little endian, and the distances). A file with other version or size, or with a wrong checksum, is not loaded
+	bool XCrossPruningTable::Load(const std::string& FileName)
+	{
+		std::ifstream In(FileName, std::ios::binary);
+		if (!In) return false;
+
+		unsigned char Header[20];
+		if (!In.read(reinterpret_cast<char*>(Header), 20) || std::string(reinterpret_cast<char*>(Header), 4) != "GRXC") return false;
+		uint Version = 0u, Size = 0u;
+		S64 Checksum = 0ull;
+		for (uint n = 0u; n < 4u; n++)
+		{
+			Version |= static_cast<uint>(Header[4 + n]) << (n << 3);
+			Size |= static_cast<uint>(Header[8 + n]) << (n << 3);
+		}
+		for (uint n = 0u; n < 8u; n++) Checksum |= static_cast<S64>(Header[12 + n]) << (n << 3);
+		if (Version != FILE_VERSION || Size != SIZE) return false;
+
+		Distances.resize(SIZE / 2u);
+		if (!In.read(reinterpret_cast<char*>(Distances.data()), SIZE / 2u) || In.peek() != std::ifstream::traits_type::eof() ||
+			GetChecksum() != Checksum)
+		{
+			Distances.clear();
+			return false;
+		}
+		return Loaded = true;
+	}
+
+	// Save the table to the given file (written to a temporary file first, so an incomplete file is never loaded)
+	bool XCrossPruningTable::Save(const std::string& FileName) const
+	{
+		const std::string TempName = FileName + ".tmp";
+		{
+			std::ofstream Out(TempName, std::ios::binary | std::ios::trunc);
+			if (!Out) return false;
+
+			const S64 Checksum = GetChecksum();
+			char Header[20] = { 'G', 'R', 'X', 'C' };
+			for (uint n = 0u; n < 4u; n++)
+			{
+				Header[4 + n] = static_cast<char>((FILE_VERSION >> (n << 3)) & 0xFFu);
+				Header[8 + n] = static_cast<char>((SIZE >> (n << 3)) & 0xFFu);
+			}
+			for (uint n = 0u; n < 8u; n++) Header[12 + n] = static_cast<char>((Checksum >> (n << 3)) & 0xFFu);
+			Out.write(Header, 20);
+			Out.write(reinterpret_cast<const char*>(Distances.data()), SIZE / 2u);
+			if (!Out.flush()) { Out.close(); std::remove(TempName.c_str()); return false; }
+		}
+		std::remove(FileName.c_str());
+		return std::rename(TempName.c_str(), FileName.c_str()) == 0;
+	}
+
+	// Checksum of the distances table (FNV-1a 64 bits), to detect corrupted table files
+	S64 XCrossPruningTable::GetChecksum() const
+	{
+		S64 Hash = 0xCBF29CE484222325ull;
+		for (const unsigned char D : Distances) Hash = (Hash ^ D) * 0x100000001B3ull;
+		return Hash;
+	}
+
+	// Build the table with a breadth-first search from the solved state
+	// The first levels expand the states found in the previous level, the last levels (when most of the states are found)
+	// look for a neighbour in the previous level for each state not found yet
+	void XCrossPruningTable::Build()
+	{
+		// New edge state (position * 2 + direction) and corner state (position * 3 + direction) after each movement,
+		// found applying the movements to cubes with the FR edge and the DFR corner in each state
+		uint EdgeMoves[24][18], CornerMoves[24][18];
+		std::vector<Cube> EdgeCubes(24u), CornerCubes(24u);
+		bool EdgeFound[24] = { false }, CornerFound[24] = { false };
+		EdgeFound[0] = CornerFound[4u * 3u] = true;
+		EdgeCubes[0] = CornerCubes[4u * 3u] = Cube();
+		for (bool Changes = true; Changes;)
+		{
+			Changes = false;
+			for (uint n = 0u; n < 24u; n++)
+			{
+				for (uint m = 0u; m < 18u; m++)
+				{
+					const Steps S = static_cast<Steps>(m + static_cast<uint>(Steps::U));
+					if (EdgeFound[n])
+					{
+						Cube C = EdgeCubes[n];
+						C.ApplyStep(S);
+						uint Pos[5], Dir[5], Corner;
+						GetState(GetIndex(C.GetEdgesStatus(), C.GetCornersStatus()), Pos, Dir, Corner);
+						const uint e = Pos[4] * 2u + Dir[4];
+						EdgeMoves[n][m] = e;
+						if (!EdgeFound[e]) { EdgeFound[e] = true; EdgeCubes[e] = C; Changes = true; }
+					}
+					if (CornerFound[n])
+					{
+						Cube C = CornerCubes[n];
+						C.ApplyStep(S);
+						uint Pos[5], Dir[5], Corner;
+						GetState(GetIndex(C.GetEdgesStatus(), C.GetCornersStatus()), Pos, Dir, Corner);
+						CornerMoves[n][m] = Corner;
+						if (!CornerFound[Corner]) { CornerFound[Corner] = true; CornerCubes[Corner] = C; Changes = true; }
+					}
+				}
+			}
+		}
+
+		Distances.assign(SIZE / 2u, 0xFF);
+		SetDistance(GetIndex(Cube().GetEdgesStatus(), Cube().GetCornersStatus()), 0u);
+
+		uint Pos[5], Dir[5], Corner, NewPos[5], NewDir[5], Found = 1u;
+		for (uint d = 0u; Found < SIZE && d + 1u < UNKNOWN; d++)
+		{
+			const bool Backwards = Found > SIZE / 4u;
+			for (uint i = 0u; i < SIZE; i++)
+			{
+				if (GetDistance(i) != (Backwards ? UNKNOWN : d)) continue;
+				GetState(i, Pos, Dir, Corner);
+				for (uint m = 0u; m < 18u; m++)
+				{
+					for (uint n = 0u; n < 5u; n++)
+					{
+						const uint s = EdgeMoves[Pos[n] * 2u + Dir[n]][m];
+						NewPos[n] = s >> 1;
+						NewDir[n] = s & 1u;
+					}
+					const uint Index = GetIndex(NewPos, NewDir, CornerMoves[Corner][m]);
+					if (Backwards)
+					{
+						if (GetDistance(Index) == d) { SetDistance(i, d + 1u); Found++; break; }
+					}
+					else if (GetDistance(Index) == UNKNOWN) { SetDistance(Index, d + 1u); Found++; }
+				}
+			}
+		}
+	}
+
+	// Get the table index for the given edges and corners status
+	uint XCrossPruningTable::GetIndex(const S64 e, const S64 c)
+	{
+		uint Pos[5], Dir[5], Corner = 0u;
+		for (uint p = 0u; p < 12u; p++)
+		{
+			const uint Slot = EdgeSlots[(e >> (p << 2)) & 0xFull];
+			if (Slot < 5u) { Pos[Slot] = p; Dir[Slot] = static_cast<uint>((e >> (p + 48u)) & 0x1ull); }
+		}
+		for (uint p = 0u; p < 8u; p++)
+		{
+			if (((c >> (p << 3)) & 0x7ull) != static_cast<S64>(Corners::DFR)) continue;
+			Corner = p * 3u + static_cast<uint>((c >> ((p << 3) + 4u)) & 0x3ull);
+			break;
+		}
+		return GetIndex(Pos, Dir, Corner);
+	}
+
+	// Get the table index for the given edges positions and directions (positions ranked as a partial permutation) and corner
+	uint XCrossPruningTable::GetIndex(const uint* Pos, const uint* Dir, const uint Corner)
+	{
+		uint Index = 0u;
+		for (uint n = 0u; n < 5u; n++)
+		{
+			uint r = Pos[n];
+			for (uint k = 0u; k < n; k++) if (Pos[k] < Pos[n]) r--;
+			Index = Index * (12u - n) + r;
+		}
+		Index = (Index << 5) | Dir[0] | (Dir[1] << 1) | (Dir[2] << 2) | (Dir[3] << 3) | (Dir[4] << 4);
+		return Index * 24u + Corner;
+	}
+
+	// Get the edges positions and directions and the corner for the given table index
+	void XCrossPruningTable::GetState(uint Index, uint* Pos, uint* Dir, uint& Corner)
+	{
+		Corner = Index % 24u;
+		Index /= 24u;
+		for (uint n = 0u; n < 5u; n++) Dir[n] = (Index >> n) & 1u;
+		Index >>= 5;
+		uint Ranks[5];
+		for (uint n = 5u; n-- > 0u;) { Ranks[n] = Index % (12u - n); Index /= 12u - n; }
+		bool Used[12] = { false };
+		for (uint n = 0u; n < 5u; n++)
+		{
+			uint p = 0u;
+			for (uint r = Ranks[n]; Used[p] || r > 0u; p++) if (!Used[p]) r--;
+			Pos[n] = p;
+			Used[p] = true;
+		}
+	}
+}
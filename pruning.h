@@ -0,0 +1,119 @@
+/*  This file is part of "GR Cube"
+
+	Copyright (C) 2020 German Ramos Rodriguez
+
+	This program is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	This program is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+	German Ramos Rodriguez
+	Vigo, Spain
+	grvigo@hotmail.com
+*/
+
+#pragma once
+
+#include <vector>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+
+#include "cube_definitions.h"
+#include "cube.h"
+
+namespace grcube3
+{
+    // Pruning table for a cross (or any other group of four edges)
+    // Stores the minimum number of single layer movements needed to solve the edges from each state
+	class CrossPruningTable
+	{
+	public:
+		static constexpr uint SIZE = 190080u; // 12 * 11 * 10 * 9 positions * 16 directions
+
+		// Get the pruning table for the edges in the given mask (nullptr if the mask has not four edges)
+		// Each table is built the first time is requested and shared among all searches
+		static const CrossPruningTable* Get(const S64);
+
+		// Minimum number of single layer movements to solve the edges in the given cube
+		uint GetDistance(const Cube& C) const { return Distances[GetIndex(C.GetEdgesStatus())]; }
+
+	private:
+		uint Slots[16]; // Index of each edge in the group (4 if the edge is not in the group)
+		uint Homes[4]; // Solved positions for the edges in the group
+		std::vector<unsigned char> Distances; // Distances table
+
+		static uint EdgeMoves[24][18]; // New edge position and direction (position * 2 + direction) after each movement
+		static std::mutex TablesMutex; // Mutex for tables creation
+		static std::map<S64, std::unique_ptr<CrossPruningTable>> Tables; // Tables already built
+
+		CrossPruningTable(const uint*); // Build the table for the given edges positions
+
+		static void InitEdgeMoves(); // Fill the edge movements table
+		uint GetIndex(const S64) const; // Get the table index for the given edges status
+		static uint GetIndex(const uint*, const uint*); // Get the table index for the given positions and directions
+		static void GetState(uint, uint*, uint*); // Get the positions and directions for the given table index
+	};
+
+    // Pruning table for the XCross: the down cross and the front right F2L pair (four cross edges, the FR edge and the DFR corner)
+    // Stores the exact number of single layer movements needed to solve the pieces from each state (two states per byte).
+    // Other crosses and F2L slots use the same table with a cube rotation. As the table is big (and slow to build) it's
+    // stored in a file the first time, and loaded from the file in the next uses
+	class XCrossPruningTable
+	{
+	public:
+		static constexpr uint EDGES_SIZE = 3041280u; // 12 * 11 * 10 * 9 * 8 positions * 32 directions
+		static constexpr uint SIZE = EDGES_SIZE * 24u; // Edges states * 8 corner positions * 3 directions
+
+		// Set the file for the table (before the first use)
+		static void SetFile(const std::string& F) { std::lock_guard<std::mutex> guard(TableMutex); File = F; }
+
+		// Get the table, loaded from the file (or built and saved if the file is not valid) the first time is requested
+		// and shared among all searches
+		static const XCrossPruningTable* Get();
+
+		// Number of single layer movements to solve the down cross and the front right F2L pair in the given cube
+		uint GetDistance(const Cube& C) const { return GetDistance(GetIndex(C.GetEdgesStatus(), C.GetCornersStatus())); }
+
+		// Check if the table has been loaded from the file
+		bool IsLoaded() const { return Loaded; }
+
+	private:
+		std::vector<unsigned char> Distances; // Distances table (4 bits per state)
+		bool Loaded; // Table loaded from file
+
+		static constexpr uint UNKNOWN = 0xFu; // Distance not found yet
+		static constexpr uint FILE_VERSION = 2u; // Version of the table file format
+		static const uint EdgeSlots[16]; // Index of each edge in the XCross edges (5 if not in the XCross)
+		static std::string File; // Table file
+		static std::mutex TableMutex; // Mutex for table creation
+		static std::unique_ptr<XCrossPruningTable> Table; // Table already loaded or built
+
+		XCrossPruningTable() { Loaded = false; }
+
+		bool Load(const std::string&); // Load the table from the given file
+		bool Save(const std::string&) const; // Save the table to the given file
+		void Build(); // Build the table with a breadth-first search from the solved state
+		S64 GetChecksum() const; // Checksum of the distances table (FNV-1a 64 bits)
+
+		uint GetDistance(const uint Index) const { return (Distances[Index >> 1] >> ((Index & 1u) << 2)) & 0xFu; }
+		void SetDistance(const uint Index, const uint D)
+		{
+			unsigned char& Data = Distances[Index >> 1];
+			Data = static_cast<unsigned char>((Data & ~(0xFu << ((Index & 1u) << 2))) | (D << ((Index & 1u) << 2)));
+		}
+
+		static uint GetIndex(const S64, const S64); // Get the table index for the given edges and corners status
+		static uint GetIndex(const uint*, const uint*, const uint); // Get the table index for the given positions and directions
+		static void GetState(uint, uint*, uint*, uint&); // Get the edges positions and directions and the corner for the given table index
+	};
+}
@@ -0,0 +1,131 @@
+/*  This file is part of "GR Cube"
+
+	Copyright (C) 2020 German Ramos Rodriguez
+
+	This program is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	This program is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+	German Ramos Rodriguez
+	Vigo, Spain
+	grvigo@hotmail.com
+*/
+
+#include "thread_pool.h"
+
+namespace grcube3
+{
+	// Get the process-wide pool (created in the first use, stopped at the program exit)
+	ThreadPool& ThreadPool::Get()
+	{
+		static ThreadPool Pool;
+		return Pool;
+	}
+
+	// Pool constructor with the given number of threads (0: system cores)
+	ThreadPool::ThreadPool(const uint Size)
+	{
+		Stop = false;
+		Start(Size);
+	}
+
+	// Start the threads
+	void ThreadPool::Start(const uint Size)
+	{
+		uint Threads = Size > 0u ? Size : std::thread::hardware_concurrency();
+		if (Threads < 1u) Threads = 1u;
+
+		Stop = false;
+		for (uint n = 0u; n < Threads; n++) Workers.push_back(std::thread(&ThreadPool::RunWorker, this));
+	}
+
+	// Change the number of threads in the pool (0: system cores), must be called without running jobs
+	void ThreadPool::SetSize(const uint Size)
+	{
+		Shutdown();
+		Start(Size);
+	}
+
+	// Finish the pending jobs and stop the threads
+	void ThreadPool::Shutdown()
+	{
+		{
+			std::lock_guard<std::mutex> guard(PoolMutex);
+			Stop = true;
+		}
+		JobsCondition.notify_all();
+		for (auto& t : Workers) t.join();
+		Workers.clear();
+	}
+
+	// Worker thread loop
+	void ThreadPool::RunWorker()
+	{
+		while (true)
+		{
+			std::function<void()> Job;
+			{
+				std::unique_lock<std::mutex> lock(PoolMutex);
+				JobsCondition.wait(lock, [this] { return Stop || !Jobs.empty(); });
+				if (Jobs.empty()) return; // Stop requested and no more jobs
+				Job = std::move(Jobs.front());
+				Jobs.pop_front();
+			}
+			Job();
+		}
+	}
+
+	// Run a pending job in the calling thread, returns false if there are no pending jobs
+	bool ThreadPool::RunPendingJob()
+	{
+		std::function<void()> Job;
+		{
+			std::lock_guard<std::mutex> guard(PoolMutex);
+			if (Jobs.empty()) return false;
+			Job = std::move(Jobs.front());
+			Jobs.pop_front();
+		}
+		Job();
+		return true;
+	}
+
+	// Run the given job the given number of times (each one with his index as parameter) and wait until all are done
+	void ThreadPool::Run(const uint NJobs, const std::function<void(const uint)>& Job)
+	{
+		if (NJobs == 0u) return;
+
+		// Completion state (in this stack frame): the counter is only changed and read with the mutex locked, so the last job
+		// has finished with the mutex and the condition before this function can see zero and return
+		uint Remaining = NJobs; // Jobs not finished
+		std::mutex DoneMutex;
+		std::condition_variable DoneCondition;
+
+		{
+			std::lock_guard<std::mutex> guard(PoolMutex);
+			for (uint n = 0u; n < NJobs; n++)
+				Jobs.push_back([n, &Job, &Remaining, &DoneMutex, &DoneCondition]
+				{
+					Job(n);
+					std::lock_guard<std::mutex> guard(DoneMutex);
+					if (--Remaining == 0u) DoneCondition.notify_all();
+				});
+		}
+		JobsCondition.notify_all();
+
+		// Help with the pending jobs while waiting (also avoids a deadlock if this is a pool thread)
+		const auto IsDone = [&Remaining, &DoneMutex] { std::lock_guard<std::mutex> guard(DoneMutex); return Remaining == 0u; };
+		while (!IsDone() && RunPendingJob());
+
+		std::unique_lock<std::mutex> lock(DoneMutex);
+		DoneCondition.wait(lock, [&Remaining] { return Remaining == 0u; });
+	}
+}
@@ -0,0 +1,68 @@
+/*  This file is part of "GR Cube"
+
+	Copyright (C) 2020 German Ramos Rodriguez
+
+	This program is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	This program is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+	German Ramos Rodriguez
+	Vigo, Spain
+	grvigo@hotmail.com
+*/
+
+#pragma once
+
+#include <vector>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <condition_variable>
+#include <thread>
+
+#include "cube_definitions.h"
+
+namespace grcube3
+{
+    // Process-wide pool of worker threads, shared by all searches to avoid creating threads for each one
+	class ThreadPool
+	{
+	public:
+		static ThreadPool& Get(); // Get the process-wide pool (created in the first use)
+
+		ThreadPool(const uint = 0u); // Pool constructor with the given number of threads (0: system cores)
+		~ThreadPool() { Shutdown(); } // Destructor (waits for the pending jobs)
+
+		ThreadPool(const ThreadPool&) = delete;
+		ThreadPool& operator=(const ThreadPool&) = delete;
+
+		uint GetSize() const { return static_cast<uint>(Workers.size()); } // Get the number of threads in the pool
+		void SetSize(const uint); // Change the number of threads in the pool (0: system cores), must be called without running jobs
+
+		// Run the given job the given number of times (each one with his index as parameter) and wait until all are done
+		// The calling thread also runs pending jobs while waiting, so a job can run other jobs in the pool
+		void Run(const uint, const std::function<void(const uint)>&);
+
+		void Shutdown(); // Finish the pending jobs and stop the threads
+
+	private:
+		std::vector<std::thread> Workers; // Pool threads
+		std::deque<std::function<void()>> Jobs; // Pending jobs
+		std::mutex PoolMutex; // Mutex for the jobs queue
+		std::condition_variable JobsCondition; // Notify new jobs (or stop) to the threads
+		bool Stop; // The pool is stopping
+
+		void Start(const uint); // Start the threads
+		void RunWorker(); // Worker thread loop
+		bool RunPendingJob(); // Run a pending job in the calling thread, returns false if there are no pending jobs
+	};
+}